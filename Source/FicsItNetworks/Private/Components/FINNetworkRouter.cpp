@@ -20,34 +20,34 @@ AFINNetworkRouter::~AFINNetworkRouter() {}
 void AFINNetworkRouter::BeginPlay() {
 	Super::BeginPlay();
 
+	UpdateFilters();
+
 	NetworkConnector1->OnIsNetworkRouter.BindLambda([]() {
         return true;
     });
 	NetworkConnector1->OnIsNetworkPortOpen.BindLambda([this](int Port) {
-        return PortList.Contains(Port) == bIsPortWhitelist;
+        return IsPortAllowed(Port);
     });
 	NetworkConnector1->OnNetworkMessageRecieved.AddLambda([this](const FGuid& ID, const FGuid& Sender, const FGuid& Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data) {
         this->LampFlags |= FIN_NetRouter_Con1_Tx;
-        if (HandleMessage(IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector2), ID, Sender, Reciever, Port, Data))
-        	this->LampFlags |= FIN_NetRouter_Con2_Rx;
+        QueueMessage(true, ID, Sender, Reciever, Port, Data);
     });
 	NetworkConnector2->OnIsNetworkRouter.BindLambda([]() {
         return true;
     });
 	NetworkConnector2->OnIsNetworkPortOpen.BindLambda([this](int Port) {
-        return PortList.Contains(Port) == bIsPortWhitelist;
+        return IsPortAllowed(Port);
     });
 	NetworkConnector2->OnNetworkMessageRecieved.AddLambda([this](const FGuid& ID, const FGuid& Sender, const FGuid& Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data) {
         this->LampFlags |= FIN_NetRouter_Con2_Tx;
-        if (HandleMessage(IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector1), ID, Sender, Reciever, Port, Data))
-	        this->LampFlags |= FIN_NetRouter_Con1_Rx;
+        QueueMessage(false, ID, Sender, Reciever, Port, Data);
     });
 }
 
 void AFINNetworkRouter::Tick(float DeltaSeconds) {
 	Super::Tick(DeltaSeconds);
 
-	HandledMessages.Empty();
+	ForwardPendingMessages();
 
 	if (LampFlags != FIN_NetRouter_None) {
 		NetMulti_OnMessageHandled(LampFlags);
@@ -55,43 +55,71 @@ void AFINNetworkRouter::Tick(float DeltaSeconds) {
 	}
 }
 
-bool AFINNetworkRouter::HandleMessage(AFINNetworkCircuit* SendingCircuit, const FGuid& ID, const FGuid& Sender, const FGuid& Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+bool AFINNetworkRouter::QueueMessage(bool bToConnector2, const FGuid& ID, const FGuid& Sender, const FGuid& Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
+	if (!HandledMessages.TryAdd(ID)) return false;
+
 	{
-		FScopeLock Lock(&HandleMessageMutex);
-		if (HandledMessages.Contains(ID) || !SendingCircuit) return false;
-		HandledMessages.Add(ID);
+		FReadScopeLock Lock(FilterLock);
+		if (AddrFilter.Contains(Sender) != bIsAddrWhitelist) return false;
+		if (PortFilter.Contains(Port) != bIsPortWhitelist) return false;
 	}
-	
-	if (AddrList.Contains(Sender.ToString()) != bIsAddrWhitelist) return false;
-	if (PortList.Contains(Port) != bIsPortWhitelist) return false;
-	
-	bool bSent = false;
-	if (Receiver.IsValid()) {
-		UObject* Obj = SendingCircuit->FindComponent(Receiver, nullptr).GetObject();
+
+	FScopeLock Lock(&PendingMessagesMutex);
+	PendingMessages.Add(FFINNetworkRouterMessage{bToConnector2, ID, Sender, Receiver, Port, Data});
+	return true;
+}
+
+void AFINNetworkRouter::ForwardPendingMessages() {
+	TArray<FFINNetworkRouterMessage> Messages;
+	{
+		FScopeLock Lock(&PendingMessagesMutex);
+		if (PendingMessages.Num() < 1) return;
+		Swap(Messages, PendingMessages);
+	}
+
+	AFINNetworkCircuit* Circuit1 = IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector1);
+	AFINNetworkCircuit* Circuit2 = IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector2);
+	for (const FFINNetworkRouterMessage& Message : Messages) {
+		if (HandleMessage(Message.bToConnector2 ? Circuit2 : Circuit1, Message)) {
+			LampFlags |= Message.bToConnector2 ? FIN_NetRouter_Con2_Rx : FIN_NetRouter_Con1_Rx;
+		}
+	}
+}
+
+bool AFINNetworkRouter::HandleMessage(AFINNetworkCircuit* SendingCircuit, const FFINNetworkRouterMessage& Message) {
+	if (!SendingCircuit) return false;
+
+	const auto Deliver = [&Message](IFINNetworkMessageInterface* MsgI) {
+		MsgI->HandleMessage(Message.ID, Message.Sender, Message.Receiver, Message.Port, Message.Data);
+	};
+	if (Message.Receiver.IsValid()) {
+		UObject* Obj = SendingCircuit->FindComponent(Message.Receiver, nullptr).GetObject();
 		IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Obj);
 		if (NetMsgI) {
 			// send to specified component
-			NetMsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
-			bSent = true;
-		} else if (!NetMsgI) {
-			// distribute over network routers
-			for (UObject* Router : SendingCircuit->GetComponents()) {
-				IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
-				if (!MsgI || !MsgI->IsNetworkMessageRouter()) continue;
-				MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
-				bSent = true;
-			}
-		}
-	} else {
-		// distribute to components
-		for (UObject* MsgHandler : SendingCircuit->GetComponents()) {
-			IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(MsgHandler);
-			if (!MsgI) continue;
-			MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
-			bSent = true;
+			Deliver(NetMsgI);
+			return true;
 		}
+		// distribute over network routers
+		return SendingCircuit->ForEachMessageEndpoint(true, Deliver) > 0;
 	}
-	return bSent;
+	// distribute to components
+	return SendingCircuit->ForEachMessageEndpoint(false, Deliver) > 0;
+}
+
+void AFINNetworkRouter::UpdateFilters() {
+	FWriteScopeLock Lock(FilterLock);
+	PortFilter = TSet<int>(PortList);
+	AddrFilter.Reset();
+	for (const FString& Addr : AddrList) {
+		FGuid Guid;
+		if (FGuid::Parse(Addr, Guid)) AddrFilter.Add(Guid);
+	}
+}
+
+bool AFINNetworkRouter::IsPortAllowed(int Port) {
+	FReadScopeLock Lock(FilterLock);
+	return PortFilter.Contains(Port) == bIsPortWhitelist;
 }
 
 void AFINNetworkRouter::NetMulti_OnMessageHandled_Implementation(EFINNetworkRouterLampFlags Flags) {
@@ -119,14 +147,17 @@ bool AFINNetworkRouter::netPropGet_isWhitelist() {
 
 void AFINNetworkRouter::netFunc_addPortList(int port) {
 	PortList.AddUnique(port);
+	UpdateFilters();
 }
 
 void AFINNetworkRouter::netFunc_removePortList(int port) {
 	PortList.Remove(port);
+	UpdateFilters();
 }
 
 void AFINNetworkRouter::netFunc_setPortList(const TArray<int>& portList) {
 	PortList = portList;
+	UpdateFilters();
 }
 
 TArray<int> AFINNetworkRouter::netFunc_getPortList() {
@@ -143,14 +174,17 @@ bool AFINNetworkRouter::netPropGet_isAddrWhitelist() {
 
 void AFINNetworkRouter::netFunc_addAddrList(const FString& addr) {
 	AddrList.AddUnique(addr);
+	UpdateFilters();
 }
 
 void AFINNetworkRouter::netFunc_removeAddrList(const FString& addr) {
 	AddrList.Remove(addr);
+	UpdateFilters();
 }
 
 void AFINNetworkRouter::netFunc_setAddrList(const TArray<FString>& list) {
 	AddrList = list;
+	UpdateFilters();
 }
 
 TArray<FString> AFINNetworkRouter::netFunc_getAddrList() {
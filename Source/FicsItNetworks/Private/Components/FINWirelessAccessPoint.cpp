@@ -20,7 +20,7 @@ AFINWirelessAccessPoint::~AFINWirelessAccessPoint() {}
 
 float AFINWirelessAccessPoint::GetWirelessRange(AFGBuildableRadarTower* TargetTower) {
 	// Same formula as described here https://satisfactory.fandom.com/wiki/Radar_Tower
-	return FMath::Min( TargetTower->GetTowerHeight() * 2.86f + 92000.0f, 212000.0f);
+	return FMath::Min( TargetTower->GetTowerHeight() * 2.86f + 92000.0f, MaxWirelessRange);
 }
 
 bool AFINWirelessAccessPoint::IsInWirelessRange(AFGBuildableRadarTower* Tower) {
@@ -53,20 +53,19 @@ void AFINWirelessAccessPoint::BeginPlay() {
 	
 	UE_LOG(LogFicsItNetworks, Display, TEXT("FINWirelessAccessPoint::BeginPlay"));
 	if (HasAuthority()) {
-		AFINWirelessSubsystem::Get(GetWorld())->RecalculateWirelessConnections();
+		AFINWirelessSubsystem::Get(GetWorld())->AddAccessPoint(this);
 	}
 }
 
 void AFINWirelessAccessPoint::Tick(float DeltaTime) {
 	Super::Tick(DeltaTime);
-	HandledMessages.Empty();
 }
 
 void AFINWirelessAccessPoint::EndPlay(const EEndPlayReason::Type EndPlayReason) {
 	Super::EndPlay(EndPlayReason);
 
 	if (EndPlayReason == EEndPlayReason::Destroyed && HasAuthority()) {
-		AFINWirelessSubsystem::Get(GetWorld())->RecalculateWirelessConnections();
+		AFINWirelessSubsystem::Get(GetWorld())->RemoveAccessPoint(this);
 	}
 }
 
@@ -128,11 +127,7 @@ bool AFINWirelessAccessPoint::HandleMessage(EFINWirelessDirection Direction, con
 
 	const auto SendingCircuit = IFINNetworkCircuitNode::Execute_GetCircuit(NetworkConnector1);
 
-	{
-		FScopeLock Lock(&HandleMessageMutex);
-		if (HandledMessages.Contains(ID) || !SendingCircuit) return false;
-		HandledMessages.Add(ID);
-	}
+	if (!SendingCircuit || !HandledMessages.TryAdd(ID)) return false;
 
 	bool bSent = false;
 
@@ -149,21 +144,15 @@ bool AFINWirelessAccessPoint::HandleMessage(EFINWirelessDirection Direction, con
 				return true;
 			} else if (!NetMsgI) {
 				// distribute over network routers
-				for (UObject* Router : SendingCircuit->GetComponents()) {
-					IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
-					if (!MsgI || !MsgI->IsNetworkMessageRouter()) continue;
+				bSent |= SendingCircuit->ForEachMessageEndpoint(true, [&](IFINNetworkMessageInterface* MsgI) {
 					MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
-					bSent = true;
-				}
+				}) > 0;
 			}
 		} else {
 			// distribute to components
-			for (UObject* MsgHandler : SendingCircuit->GetComponents()) {
-				IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(MsgHandler);
-				if (!MsgI) continue;
+			bSent |= SendingCircuit->ForEachMessageEndpoint(false, [&](IFINNetworkMessageInterface* MsgI) {
 				MsgI->HandleMessage(ID, Sender, Receiver, Port, Data);
-				bSent = true;
-			}
+			}) > 0;
 		}
 	}
 
@@ -10,8 +10,7 @@ void AFINComputerNetworkCard::GetLifetimeReplicatedProps(TArray<FLifetimePropert
 }
 
 AFINComputerNetworkCard::AFINComputerNetworkCard() {
-	PrimaryActorTick.bCanEverTick = true;
-	SetActorTickEnabled(true);
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AFINComputerNetworkCard::BeginPlay() {
@@ -27,16 +26,12 @@ void AFINComputerNetworkCard::BeginPlay() {
 		if (!Circuit) {
 			Circuit = GetWorld()->SpawnActor<AFINNetworkCircuit>();
 			Circuit->Recalculate(this);
+		} else {
+			Circuit->UpdateNode(this);
 		}
 	}
 }
 
-void AFINComputerNetworkCard::Tick(float DeltaSeconds) {
-	Super::Tick(DeltaSeconds);
-
-	HandledMessages.Empty();
-}
-
 FGuid AFINComputerNetworkCard::GetID_Implementation() const {
 	return ID;
 }
@@ -47,6 +42,7 @@ FString AFINComputerNetworkCard::GetNick_Implementation() const {
 
 void AFINComputerNetworkCard::SetNick_Implementation(const FString& nick) {
 	Nick = nick;
+	if (Circuit) Circuit->UpdateNode(this);
 }
 
 bool AFINComputerNetworkCard::HasNick_Implementation(const FString& nick) {
@@ -84,11 +80,7 @@ bool AFINComputerNetworkCard::IsPortOpen(int Port) {
 void AFINComputerNetworkCard::HandleMessage(const FGuid& InID, const FGuid& Sender, const FGuid& Receiver, int Port, const TArray<FFINAnyNetworkValue>& Data) {
 	static UFINSignal* Signal = nullptr;
 	if (!Signal) Signal = FFINReflection::Get()->FindClass(StaticClass())->FindFINSignal("NetworkMessage");
-	{
-		FScopeLock Lock(&HandledMessagesMutex);
-		if (HandledMessages.Contains(InID) || !Signal) return;
-		HandledMessages.Add(InID);
-	}
+	if (!Signal || !HandledMessages.TryAdd(InID)) return;
 	if (!IsPortOpen(Port)) return;
 	if (Receiver.IsValid() && Receiver != ID) return;
 	TArray<FFINAnyNetworkValue> Parameters = { Sender.ToString(), (FINInt)Port };
@@ -149,11 +141,9 @@ void AFINComputerNetworkCard::netFunc_send(FString receiver, int port, TArray<FF
 		NetMsgI->HandleMessage(MsgID, SenderID, receiverID, port, args);
 	} else {
 		// distribute to all routers
-		for (UObject* Router : Circuit->GetComponents()) {
-			IFINNetworkMessageInterface* MsgI = Cast<IFINNetworkMessageInterface>(Router);
-			if (!MsgI || !MsgI->IsNetworkMessageRouter()) continue;
+		Circuit->ForEachMessageEndpoint(true, [&](IFINNetworkMessageInterface* MsgI) {
 			MsgI->HandleMessage(MsgID, SenderID, receiverID, port, args);
-		}
+		});
 	}
 }
 
@@ -161,10 +151,7 @@ void AFINComputerNetworkCard::netFunc_broadcast(int port, TArray<FFINAnyNetworkV
  	if (!CheckNetMessageData(args) || port < 0 || port > 10000) return;
 	FGuid MsgID = FGuid::NewGuid();
 	FGuid SenderID = Execute_GetID(this);
-	for (UObject* Component : GetCircuit_Implementation()->GetComponents()) {
-		IFINNetworkMessageInterface* NetMsgI = Cast<IFINNetworkMessageInterface>(Component);
-		if (NetMsgI) {
-			NetMsgI->HandleMessage(MsgID, SenderID, FGuid(), port, args);
-		}
-	}
+	GetCircuit_Implementation()->ForEachMessageEndpoint(false, [&](IFINNetworkMessageInterface* NetMsgI) {
+		NetMsgI->HandleMessage(MsgID, SenderID, FGuid(), port, args);
+	});
 }
@@ -22,7 +22,7 @@ CodersFileSystem::SRef<CodersFileSystem::Node> FFileSystemNodeIndex::Deserialize
 		if (!stream) return nullptr;
 		try {
 			FTCHARToUTF8 Convert(*Node->Data, Node->Data.Len());
-			stream->write(std::string(Convert.Get(), Convert.Length()));
+			stream->write(Convert.Get(), Convert.Length());
 			stream->close();
 		} catch (...) {
 			UE_LOG(LogFicsItNetworks, Error, TEXT("Unable to deserialize VFS-File"));
@@ -40,13 +40,21 @@ namespace CodersFileSystem {
 	}
 
 	bool ByteCountedDevice::checkSizeFunc(long long size, bool addIfAble) {
-		if (capacity < 1) return true;
-		size_t newUsed = getUsed();
-		if (newUsed + size > capacity) return false;
-		used += size;
+		if (capacity > 0 && size > 0 && getUsed() + size > capacity) return false;
+		if (addIfAble) addUsed(size);
 		return true;
 	}
 
+	void ByteCountedDevice::addUsed(long long delta) {
+		if (!usedValid) return;
+		if (delta < 0 && static_cast<size_t>(-delta) > used) used = 0;
+		else used += delta;
+	}
+
+	size_t ByteCountedDevice::recountUsed() {
+		return getSize();
+	}
+
 	ByteCountedDevice::ByteCountedDevice(size_t capacity) : capacity(capacity) {
 		addListener(byteCountedDeviceListener = new ByteCountedDeviceListener(this));
 		checkSize = std::bind(&ByteCountedDevice::checkSizeFunc, this, std::placeholders::_1, std::placeholders::_2);
@@ -55,7 +63,7 @@ namespace CodersFileSystem {
 	size_t ByteCountedDevice::getUsed() {
 		if (capacity < 1) return 0;
 		if (!usedValid) {
-			used = this->getSize();
+			used = recountUsed();
 			usedValid = true;
 		}
 		return used;
@@ -79,10 +87,36 @@ namespace CodersFileSystem {
 		return getSizeFromNode(root);
 	}
 
+	size_t MemDevice::recountUsed() {
+		return root->getSize();
+	}
+
+	MemDevice::MemDevicePathCacheListener::MemDevicePathCacheListener(MemDevice* device) : device(device) {}
+
+	void MemDevice::MemDevicePathCacheListener::onNodeRemoved(Path path, NodeType type) {
+		device->invalidatePathCache(path);
+	}
+
+	void MemDevice::MemDevicePathCacheListener::onNodeRenamed(Path newPath, Path oldPath, NodeType type) {
+		device->invalidatePathCache(oldPath);
+	}
+
 	MemDevice::MemDevice(size_t capacity) : ByteCountedDevice(capacity) {
+		// the directories keep track of their size
+		listenerMask = 0;
+		addListener(pathCacheListener = new MemDevicePathCacheListener(this));
 		root = new MemDirectory({listeners, ""}, checkSize);
 	}
 
+	void MemDevice::invalidatePathCache(const Path& path) {
+		Path removed = path.relative();
+		std::lock_guard<std::mutex> lock(pathCacheMutex);
+		for (auto entry = pathCache.begin(); entry != pathCache.end();) {
+			if (entry->first.startsWith(removed)) entry = pathCache.erase(entry);
+			else ++entry;
+		}
+	}
+
 	SRef<FileStream> MemDevice::open(Path path, FileMode mode) {
 		auto node = get(path);
 		if (!node.isValid() && mode & FileMode::OUTPUT) {
@@ -123,9 +157,27 @@ namespace CodersFileSystem {
 	}
 
 	SRef<Node> MemDevice::get(Path path) {
-		path = path.normalize().absolute();
-		if (path.isRoot()) return root;
 		path = path.relative();
+		if (path.isEmpty()) return root;
+		{
+			std::lock_guard<std::mutex> lock(pathCacheMutex);
+			auto cached = pathCache.find(path);
+			if (cached != pathCache.end()) {
+				SRef<Node> node = cached->second;
+				if (node.isValid()) return node;
+				pathCache.erase(cached);
+			}
+		}
+		SRef<Node> node = resolve(path);
+		if (node.isValid()) {
+			std::lock_guard<std::mutex> lock(pathCacheMutex);
+			if (pathCache.size() >= maxCachedPaths) pathCache.clear();
+			pathCache[path] = node;
+		}
+		return node;
+	}
+
+	SRef<Node> MemDevice::resolve(Path path) {
 		SRef<MemDirectory> dir = root;
 		while (!path.isSingle() && dir.isValid()) {
 			dir = dir->get(path.getRoot());
@@ -159,8 +211,94 @@ namespace CodersFileSystem {
 		return getSizeFromPath(realPath);
 	}
 
+	size_t DiskDevice::recountUsed() {
+		nodeUsage.clear();
+		long long count = realPath.filename().string().length();
+		std::error_code error;
+		for (fs::recursive_directory_iterator i(realPath, error), end; !error && i != end; i.increment(error)) {
+			count += indexUsage(i->path());
+		}
+		return count;
+	}
+
+	std::string DiskDevice::getUsageKey(const fs::path& path) const {
+		return path.lexically_normal().lexically_relative(realPath.lexically_normal()).generic_string();
+	}
+
+	long long DiskDevice::indexUsage(const fs::path& path) {
+		std::string key = getUsageKey(path);
+		std::error_code error;
+		fs::file_status status = fs::status(path, error);
+		if (error || !(fs::is_directory(status) || fs::is_regular_file(status))) return unindexUsage(key);
+		std::uintmax_t usage = path.filename().string().length();
+		if (fs::is_regular_file(status)) {
+			std::uintmax_t fileSize = fs::file_size(path, error);
+			if (!error) usage += fileSize;
+		}
+		std::uintmax_t& entry = nodeUsage[key];
+		long long delta = static_cast<long long>(usage) - static_cast<long long>(entry);
+		entry = usage;
+		return delta;
+	}
+
+	long long DiskDevice::unindexUsage(const std::string& key) {
+		long long delta = 0;
+		auto entry = nodeUsage.find(key);
+		if (entry != nodeUsage.end()) {
+			delta -= entry->second;
+			nodeUsage.erase(entry);
+		}
+		std::string prefix = key + "/";
+		auto child = nodeUsage.lower_bound(prefix);
+		while (child != nodeUsage.end() && child->first.compare(0, prefix.length(), prefix) == 0) {
+			delta -= child->second;
+			child = nodeUsage.erase(child);
+		}
+		return delta;
+	}
+
+	void DiskDevice::updateUsage(int eventType, const Path& to, const Path& from) {
+		if (!usedValid) return;
+		fs::path spath = realPath / to.relative().str();
+		long long delta = 0;
+		switch (eventType) {
+		case 3:
+			delta += unindexUsage(getUsageKey(realPath / from.relative().str()));
+			[[fallthrough]];
+		case 0:
+			delta += indexUsage(spath);
+			if (fs::is_directory(spath)) {
+				std::error_code error;
+				for (fs::recursive_directory_iterator i(spath, error), end; !error && i != end; i.increment(error)) {
+					delta += indexUsage(i->path());
+				}
+			}
+			break;
+		case 1:
+			delta += unindexUsage(getUsageKey(spath));
+			break;
+		case 2:
+			delta += indexUsage(spath);
+			break;
+		}
+		addUsed(delta);
+	}
+
+	SizeCheckFunc DiskDevice::checkSizeFor(const fs::path& path) {
+		std::string key = getUsageKey(path);
+		return [this, key](long long size, bool addIfAble) {
+			if (!checkSizeFunc(size, addIfAble)) return false;
+			if (addIfAble && usedValid) {
+				std::uintmax_t& entry = nodeUsage[key];
+				entry = (size < 0 && static_cast<std::uintmax_t>(-size) > entry) ? 0 : entry + size;
+			}
+			return true;
+		};
+	}
+
 	DiskDevice::DiskDevice(fs::path realPath, size_t capacity) : ByteCountedDevice(capacity), realPath(realPath), watcher(realPath,
 		[&](int eventType, auto node, auto to, auto from) {
+			updateUsage(eventType, to, from);
 			switch (eventType) {
 			case 0:
 				listeners.onNodeAdded(to, node);
@@ -176,6 +314,8 @@ namespace CodersFileSystem {
 				break;
 			}
 		}) {
+		// the node usage gets updated with the watcher events
+		listenerMask = 0;
 		getUsed();
 	}
 
@@ -183,7 +323,7 @@ namespace CodersFileSystem {
 		std::filesystem::path spath = realPath / path.relative().str();
 		if (fs::exists(spath) && !fs::is_regular_file(spath)) return nullptr;
 		else if (!fs::is_directory(spath / "..")) return nullptr;
-		return new DiskFileStream(spath, mode, checkSize);
+		return new DiskFileStream(spath, mode, checkSizeFor(spath));
 	}
 
 	SRef<Directory> DiskDevice::createDir(Path path, bool createTree) {
@@ -206,9 +346,11 @@ namespace CodersFileSystem {
 		if (path.isEmpty()) return false;
 		std::filesystem::path spath = realPath / path.relative().str();
 		try {
-			if (recursive) return fs::remove_all(spath) > 0;
-			else return fs::remove(spath);
+			bool removed;
+			if (recursive) removed = fs::remove_all(spath) > 0;
+			else removed = fs::remove(spath);
 			tickWatcher();
+			return removed;
 		} catch (...) {
 			return false;
 		}
@@ -226,12 +368,13 @@ namespace CodersFileSystem {
 
 	SRef<Node> DiskDevice::get(Path path) {
 		path = path.normalize();
-		if (path.isEmpty()) return new DiskDirectory(realPath, checkSize);
+		SizeCheckFactory checkSizeFactory = [this](const fs::path& path) { return checkSizeFor(path); };
+		if (path.isEmpty()) return new DiskDirectory(realPath, checkSizeFactory);
 		std::filesystem::path spath = realPath / path.relative().str();
 		if (fs::is_regular_file(spath)) {
-			return new DiskFile(spath, checkSize);
+			return new DiskFile(spath, checkSizeFor(spath));
 		} else if (fs::is_directory(spath)) {
-			return new DiskDirectory(spath, checkSize);
+			return new DiskDirectory(spath, checkSizeFactory);
 		}
 		return nullptr;
 	}
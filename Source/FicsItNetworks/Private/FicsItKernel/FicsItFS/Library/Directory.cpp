@@ -10,15 +10,51 @@ Directory::~Directory() {}
 
 MemDirectory::MemDirectory(ListenerListRef listeners, SizeCheckFunc checkSize) : Directory(), listeners(listeners), checkSize(checkSize) {}
 
-MemDirectory::~MemDirectory() {}
+MemDirectory::~MemDirectory() {
+	for (auto& entry : entries) detach(entry.second);
+}
+
+bool MemDirectory::resize(long long delta) {
+	if (parent) {
+		if (!parent->resize(delta)) return false;
+	} else if (!checkSize(delta, true)) return false;
+	size = delta < 0 && static_cast<size_t>(-delta) > size ? 0 : size + delta;
+	return true;
+}
+
+size_t MemDirectory::attach(const SRef<Node>& node) {
+	if (MemDirectory* dir = dynamic_cast<MemDirectory*>(node.get())) {
+		dir->parent = this;
+		return dir->getSize();
+	}
+	if (MemFile* file = dynamic_cast<MemFile*>(node.get())) {
+		file->parent = this;
+		return file->getSize();
+	}
+	return 0;
+}
+
+size_t MemDirectory::detach(const SRef<Node>& node) {
+	if (MemDirectory* dir = dynamic_cast<MemDirectory*>(node.get())) {
+		dir->parent = nullptr;
+		return dir->getSize();
+	}
+	if (MemFile* file = dynamic_cast<MemFile*>(node.get())) {
+		file->parent = nullptr;
+		return file->getSize();
+	}
+	return 0;
+}
+
+size_t MemDirectory::getSize() const {
+	return size;
+}
 
 SRef<Node> CodersFileSystem::MemDirectory::get(const std::string& name) {
 	if (name.length() < 1) return nullptr;
-	try {
-		return entries.at(name);
-	} catch (...) {
-		return nullptr;
-	}
+	auto entry = entries.find(name);
+	if (entry == entries.end()) return nullptr;
+	return entry->second;
 }
 
 unordered_set<std::string> MemDirectory::getChilds() const {
@@ -37,8 +73,9 @@ bool CodersFileSystem::MemDirectory::isValid() const {
 
 WRef<Directory> MemDirectory::createSubdir(const std::string& subdir) {
 	if (entries.find(subdir) != entries.end()) return entries[subdir];
-	if (!checkSize(subdir.length(), true)) return nullptr;
-	auto dir = new MemDirectory(ListenerListRef{listeners, Path(subdir)}, checkSize);
+	if (!resize(subdir.length())) return nullptr;
+	SRef<MemDirectory> dir = new MemDirectory(ListenerListRef{listeners, Path(subdir)}, [](auto, auto) { return true; });
+	attach(dir);
 	entries[subdir] = dir;
 	listeners.onNodeAdded(Path(subdir), NT_Directory);
 	return dir;
@@ -47,8 +84,9 @@ WRef<Directory> MemDirectory::createSubdir(const std::string& subdir) {
 WRef<File> MemDirectory::createFile(const std::string& name) {
 	if (!Path::isNode(name)) return nullptr;
 	if (entries.find(name) != entries.end()) return entries[name];
-	if (!checkSize(name.length(), true)) return nullptr;
-	auto file = new MemFile(ListenerListRef{listeners, Path(name)}, checkSize);
+	if (!resize(name.length())) return nullptr;
+	SRef<MemFile> file = new MemFile(ListenerListRef{listeners, Path(name)});
+	attach(file);
 	entries[name] = file;
 	listeners.onNodeAdded(Path(name), NT_File);
 	return file;
@@ -65,8 +103,10 @@ bool MemDirectory::remove(const std::string& entry, bool recursive) {
 			ret = ret & dir->remove(child, true);
 		}
 	}
-	listeners.onNodeAdded(Path(entry), getTypeFromRef(e_p->second));
+	listeners.onNodeRemoved(Path(entry), getTypeFromRef(e_p->second));
+	const size_t removedSize = entry.length() + detach(e_p->second);
 	entries.erase(e_p);
+	resize(-static_cast<long long>(removedSize));
 	return true;
 }
 
@@ -74,7 +114,7 @@ bool MemDirectory::rename(const std::string& entry, const std::string& name) {
 	if (!Path::isNode(name)) return false;
 	auto e_p = entries.find(entry);
 	if (e_p == entries.end() || entries.find(name) != entries.end()) return false;
-	if (entry.length() < name.length() && !checkSize(name.length() - entry.length(), true)) return false;
+	if (!resize(static_cast<long long>(name.length()) - static_cast<long long>(entry.length()))) return false;
 	entries[name] = e_p->second;
 	listeners.onNodeRenamed(Path(name), Path(entry), getTypeFromRef(e_p->second));
 	entries.erase(e_p);
@@ -85,13 +125,17 @@ bool MemDirectory::add(const SRef<Node>& node, const std::string& name) {
 	if (!Path::isNode(name)) return false;
 	if (!node.isValid()) return false;
 	if (entries.find(name) != entries.end()) return false;
-	if (!checkSize(name.length(), true)) return false;
+	size_t nodeSize = 0;
+	if (MemDirectory* dir = dynamic_cast<MemDirectory*>(node.get())) nodeSize = dir->getSize();
+	else if (MemFile* file = dynamic_cast<MemFile*>(node.get())) nodeSize = file->getSize();
+	if (!resize(name.length() + nodeSize)) return false;
+	attach(node);
 	entries[name] = node;
 	listeners.onNodeAdded(Path(name), getTypeFromRef(node));
 	return true;
 }
 
-DiskDirectory::DiskDirectory(const std::filesystem::path& realpath, SizeCheckFunc checkSize) : Directory(), realPath(realpath), checkSize(checkSize) {}
+DiskDirectory::DiskDirectory(const std::filesystem::path& realpath, SizeCheckFactory checkSize) : Directory(), realPath(realpath), checkSize(checkSize) {}
 
 DiskDirectory::~DiskDirectory() {}
 
@@ -126,7 +170,7 @@ WRef<File> DiskDirectory::createFile(const std::string& name) {
 	fstream f;
 	f.open(realPath / name, fstream::out);
 	f.close();
-	return new DiskFile(realPath / name, checkSize);
+	return new DiskFile(realPath / name, checkSize(realPath / name));
 }
 
 bool DiskDirectory::remove(const std::string& subdir, bool recursive) {
@@ -1,4 +1,9 @@
 #include "FicsItKernel/FicsItFS/Library/File.h"
+#include "FicsItKernel/FicsItFS/Library/Directory.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 using namespace std;
@@ -26,7 +31,9 @@ MemFile::MemFile(ListenerListRef listeners, SizeCheckFunc sizeCheck) : File(), l
 
 SRef<FileStream> MemFile::open(FileMode m) {
 	if (io.isValid() && io->isOpen()) return nullptr;
-	SRef<MemFileStream> FS = new MemFileStream(&data, m, listeners, sizeCheck);
+	SRef<MemFileStream> FS = new MemFileStream(&data, m, listeners, [this](long long delta, bool addIfAble) {
+		return resize(delta, addIfAble);
+	});
 	io = FS;
 	return FS;
 }
@@ -39,12 +46,35 @@ size_t MemFile::getSize() const {
 	return data.length();
 }
 
+bool MemFile::resize(long long delta, bool addIfAble) {
+	if (parent) return parent->resize(delta);
+	return sizeCheck(delta, addIfAble);
+}
+
 FileStream::FileStream(FileMode mode) : mode(mode) {}
 
 FileMode FileStream::getMode() const {
 	return mode;
 }
 
+void FileStream::write(std::string_view str) {
+	write(str.data(), str.size());
+}
+
+std::string FileStream::read(size_t chars) {
+	std::string str;
+	size_t length = 0;
+	while (length < chars) {
+		const size_t chunk = std::min(chars - length, BufferSize);
+		str.resize(length + chunk);
+		const size_t count = read(str.data() + length, chunk);
+		length += count;
+		if (count < chunk) break;
+	}
+	str.resize(length);
+	return str;
+}
+
 FileStream& FileStream::operator<<(const std::string& str) {
 	write(str);
 
@@ -53,15 +83,21 @@ FileStream& FileStream::operator<<(const std::string& str) {
 
 std::string FileStream::readAll(SRef<FileStream> stream) {
 	std::string str;
+	size_t length = 0;
 	do {
-		str.append(stream->read(1024));
+		str.resize(length + BufferSize);
+		length += stream->read(str.data() + length, BufferSize);
 	} while (!stream->isEOF());
+	str.resize(length);
 	return str;
 }
 
 MemFileStream::MemFileStream(string * data, FileMode mode, ListenerListRef& listeners, SizeCheckFunc sizeCheck) : FileStream(mode), data(data), listeners(listeners), sizeCheck(sizeCheck) {
 	if ((mode & CodersFileSystem::OUTPUT) && (mode & CodersFileSystem::APPEND)) pos = data->length();
-	else if (mode & CodersFileSystem::TRUNC) *data = "";
+	else if (mode & CodersFileSystem::TRUNC) {
+		sizeCheck(-static_cast<long long>(data->length()), true);
+		*data = "";
+	}
 	open = true;
 }
 
@@ -69,25 +105,27 @@ MemFileStream::~MemFileStream() {
 	close();
 }
 
-void MemFileStream::write(string newData) {
+void MemFileStream::write(const char* newData, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
-	if (!sizeCheck(data->length(), true)) throw std::exception("out of memory");
-	data->erase(pos, newData.length());
-	data->insert(pos, newData);
-	pos += newData.length();
+	if (pos > data->length()) throw std::out_of_range("filestream position out of range");
+	// overwritten content doesn't need additional space
+	const long long growth = static_cast<long long>(pos + length) - static_cast<long long>(data->length());
+	if (growth > 0 && !sizeCheck(growth, true)) throw std::exception("out of memory");
+	data->replace(pos, length, newData, length);
+	pos += length;
 }
 
-string MemFileStream::read(size_t chars) {
+size_t MemFileStream::read(char* buffer, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
 	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
 	if (pos >= data->size()) {
 		flagEOF = true;
-		return "";
+		return 0;
 	}
 	flagEOF = false;
-	string buf = data->substr(pos, chars);
-	pos += buf.length();
-	return buf;
+	const size_t count = data->copy(buffer, length, pos);
+	pos += count;
+	return count;
 }
 
 bool MemFileStream::isEOF() {
@@ -143,36 +181,98 @@ DiskFileStream::DiskFileStream(filesystem::path realPath, FileMode mode, SizeChe
 	if (mode & FileMode::TRUNC) nativeMode |= ios::trunc;
 	if (mode & FileMode::BINARY) nativeMode |= ios::binary;
 
-	stream = std::fstream(realPath, nativeMode);
+	if ((mode & FileMode::OUTPUT) || !tryMapFile()) {
+		streamBuffer = std::make_unique<char[]>(BufferSize);
+		// MSVC only accepts a buffer for an open file, other standard libraries only accept it before the file gets opened
+#if PLATFORM_WINDOWS
+		stream.open(realPath, nativeMode);
+		stream.rdbuf()->pubsetbuf(streamBuffer.get(), BufferSize);
+#else
+		stream.rdbuf()->pubsetbuf(streamBuffer.get(), BufferSize);
+		stream.open(realPath, nativeMode);
+#endif
+	}
+
+	std::error_code error;
+	const std::uintmax_t fileSize = filesystem::file_size(realPath, error);
+	if (!error) size = static_cast<std::int64_t>(fileSize);
 }
 
-DiskFileStream::~DiskFileStream() {}
+DiskFileStream::~DiskFileStream() {
+	close();
+}
 
-void DiskFileStream::write(string data) {
+bool DiskFileStream::tryMapFile() {
+#if PLATFORM_LINUX
+	// mapped files on windows can't get truncated by other streams, so only use mmap on linux.
+	// the mapping is a snapshot of the file when it got opened, content written by other streams
+	// afterwards is not visible, so only read-only streams get mapped
+	if (!(mode & FileMode::INPUT) || (mode & (FileMode::OUTPUT | FileMode::TRUNC))) return false;
+	mappedFile.reset(IPlatformFile::GetPlatformPhysical().OpenMapped(*FString(path.wstring().c_str())));
+	// empty files can't get mapped
+	if (!mappedFile || mappedFile->GetFileSize() < 1) {
+		mappedFile.reset();
+		return false;
+	}
+	mappedRegion.reset(mappedFile->MapRegion(0, mappedFile->GetFileSize()));
+	if (!mappedRegion) {
+		mappedFile.reset();
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DiskFileStream::write(const char* data, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
-	if (!sizeCheck(data.length(), true)) throw std::exception("out of capacity");
-	stream << data;
+	if (mappedRegion) throw std::exception("filestream not in output mode");
+	std::int64_t pos = (mode & FileMode::APPEND) ? size : static_cast<std::int64_t>(stream.tellp());
+	if (pos < 0) pos = size;
+	// overwritten content doesn't need additional space
+	const std::int64_t end = pos + static_cast<std::int64_t>(length);
+	if (end > size && !sizeCheck(end - size, true)) throw std::exception("out of capacity");
+	stream.write(data, length);
+	// flush every write, so other streams of the file see the data and a following read
+	// on an input/output stream doesn't continue directly from unflushed output
 	stream.flush();
+	size = std::max(size, end);
 }
 
-string DiskFileStream::read(size_t chars) {
+size_t DiskFileStream::read(char* buffer, size_t length) {
 	if (!isOpen()) throw std::exception("filestream not open");
 	if (!(mode & FileMode::INPUT)) throw std::exception("filestream not in input mode");
-	string s;
-	// Ensure buffer is large enough to hold characters.
-	s.resize(chars);
-	stream.read(const_cast<char*>(s.data()), chars);
-	// Shrink the string to the actual number of characters we read.
-	s.resize(stream.gcount());
-	return s;
+	if (mappedRegion) {
+		const std::int64_t mappedSize = mappedRegion->GetMappedSize();
+		const size_t count = static_cast<size_t>(std::min<std::int64_t>(length, std::max<std::int64_t>(mappedSize - mappedPos, 0)));
+		memcpy(buffer, mappedRegion->GetMappedPtr() + mappedPos, count);
+		mappedPos += count;
+		// same as the fstream, reading less than requested sets EOF
+		mappedEOF = count < length;
+		return count;
+	}
+	stream.read(buffer, length);
+	return stream.gcount();
 }
 
 bool DiskFileStream::isEOF() {
+	if (mappedRegion) return mappedEOF;
 	return stream.eof();
 }
 
 int64_t DiskFileStream::seek(string str, int64_t off) {
 	if (!isOpen()) throw std::exception("filestream not open");
+	if (mappedRegion) {
+		const std::int64_t mappedSize = mappedRegion->GetMappedSize();
+		if (str == "set") mappedPos = off;
+		else if (str == "cur") mappedPos += off;
+		else if (str == "end") mappedPos = mappedSize + off;
+		else throw std::exception("Invalid whence");
+		mappedPos = std::clamp<std::int64_t>(mappedPos, 0, mappedSize);
+		mappedEOF = false;
+		return mappedPos;
+	}
 	enum {
 		WHENCE_INVALID,
 		WHENCE_SET,
@@ -186,6 +286,9 @@ int64_t DiskFileStream::seek(string str, int64_t off) {
 
 	if (whence == WHENCE_INVALID) throw std::exception("Invalid whence");
 
+	// a read hitting EOF also sets the fail flag, which would make the seek fail
+	stream.clear();
+
 	if (mode & FileMode::INPUT) {
 		switch (whence) {
 		case WHENCE_SET:
@@ -223,11 +326,13 @@ int64_t DiskFileStream::seek(string str, int64_t off) {
 }
 
 void DiskFileStream::close() {
-	if (isOpen()) {
+	mappedRegion.reset();
+	mappedFile.reset();
+	if (stream.is_open()) {
 		stream.close();
 	}
 }
 
 bool DiskFileStream::isOpen() {
-	return stream.is_open();
+	return mappedRegion || stream.is_open();
 }
@@ -1,7 +0,0 @@
-#include "FicsItKernel/FicsItFS/Library/Path.h"
-
-using namespace std;
-using namespace CodersFileSystem;
-
-std::regex CodersFileSystem::Path::sepperatorPattern("[\\\\\\/\\|]");
-std::regex CodersFileSystem::Path::nodePattern("^(?!([.~]+$))[^\\\\\\/\\|]+$");
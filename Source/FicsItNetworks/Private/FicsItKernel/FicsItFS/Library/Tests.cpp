@@ -1,5 +1,12 @@
 #include "FicsItKernel/FicsItFS/Library/Tests.h"
 #include "FicsItKernel/FicsItFS/Library/Path.h"
+#include "FicsItKernel/FicsItFS/Library/ReferenceCount.h"
+
+#include "Misc/AutomationTest.h"
+#include <random>
+#include <regex>
+#include <thread>
+#include <vector>
 
 using namespace CodersFileSystem;
 using namespace CodersFileSystem::Tests;
@@ -82,3 +89,254 @@ void CodersFileSystem::Tests::TestPath() {
 	check(rootOverride.fileName() == "meep");
 	check(!rootOverride.isDir());
 }
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+	/*
+	* the former regex based path implementation, used as reference for the path equivalence tests
+	*/
+	struct RegexPath {
+		static const std::regex& sepperatorPattern() {
+			static std::regex pattern("[\\\\\\/\\|]");
+			return pattern;
+		}
+
+		static const std::regex& nodePattern() {
+			static std::regex pattern("^(?!([.~]+$))[^\\\\\\/\\|]+$");
+			return pattern;
+		}
+
+		static bool isNode(const std::string& str) {
+			return std::regex_match(str, nodePattern());
+		}
+
+		std::string path;
+
+		RegexPath() = default;
+		RegexPath(std::string str) {
+			if (str.size() < 1) return;
+			if (str[0] == '/') path = "/";
+			std::smatch match;
+			while (std::regex_search(str, match, sepperatorPattern())) {
+				if (0 != match.position()) {
+					std::string node = str.substr(0, match.position());
+					append(node);
+				} else {
+					path = "/";
+				}
+				str = match.suffix();
+			}
+			if (str.length() < 1 && path.size() > 0 && path[path.size()-1] != '/') path += "/";
+			else append(str);
+		}
+
+		RegexPath& append(std::string node) {
+			size_t pos = path.find_last_of("/");
+			if (node == "." || node == ".." || isNode(node)) {
+				if (pos != path.size()-1) path.append("/");
+				path.append(node);
+			} else if (node == "/") {
+				path.append(node);
+			}
+			return *this;
+		}
+
+		bool isAbsolute() const {
+			return path.substr(0, 1) == "/";
+		}
+
+		RegexPath normalize() const {
+			RegexPath newPath;
+			if (isAbsolute()) newPath.path = "/";
+			size_t posEnd, posStart = 0;
+			do {
+				posEnd = path.find_first_of("/", posStart);
+				std::string node = path.substr(posStart, posEnd-posStart);
+				posStart = posEnd+1;
+				if (node == ".") {
+				} else if (node == "..") {
+					size_t pos = newPath.path.find_last_of("/");
+					if (pos == std::string::npos) {
+						newPath.path = "";
+					} else {
+						newPath.path.erase(pos);
+					}
+					if (newPath.path.size() < 1 && isAbsolute()) newPath.path = "/";
+				} else if (isNode(node)) {
+					if (newPath.path.size() > 0 && newPath.path.back() != '/') {
+						newPath.path.append("/");
+					}
+					newPath.path.append(node);
+				}
+			} while (posEnd != std::string::npos);
+			return newPath;
+		}
+
+		RegexPath absolute() const {
+			if (isAbsolute()) return normalize();
+			return "/" + normalize().path;
+		}
+
+		RegexPath relative() const {
+			if (isAbsolute()) return normalize().path.substr(1);
+			return normalize();
+		}
+
+		RegexPath operator/(const RegexPath& other) const {
+			if (other.isAbsolute()) return other;
+			RegexPath newPath = *this;
+			size_t posEnd, posStart = 0;
+			do {
+				posEnd = other.path.find_first_of("/", posStart);
+				newPath.append(other.path.substr(posStart, posEnd-posStart));
+				posStart = posEnd+1;
+			} while (posEnd != std::string::npos);
+			return newPath;
+		}
+
+		bool startsWith(const RegexPath& other) const {
+			RegexPath o = isAbsolute() ? other.absolute() : other.relative();
+			return path.substr(0, o.path.size()) == o.path;
+		}
+
+		bool operator==(const RegexPath& other) const {
+			return relative().path == other.relative().path;
+		}
+	};
+
+	std::string RandomPathString(std::mt19937& random) {
+		static const char* parts[] = {"a", "b", "test", "test.lua", ".", "..", "...", "~", ".~", "~a", ".a", "a.", " ", "/", "/", "\\", "|", "//"};
+		std::uniform_int_distribution<size_t> countDist(0, 8);
+		std::uniform_int_distribution<size_t> partDist(0, std::size(parts)-1);
+		std::string str;
+		for (size_t i = countDist(random); i > 0; --i) str += parts[partDist(random)];
+		return str;
+	}
+}
+
+/*
+* compares the path implementation with the former regex based one on randomly generated paths
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINFileSystemPathEquivalenceTest, "FicsItNetworks.FileSystem.PathEquivalence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFINFileSystemPathEquivalenceTest::RunTest(const FString& Parameters) {
+	std::mt19937 random(1337);
+	for (int i = 0; i < 1000; ++i) {
+		std::string str = RandomPathString(random);
+		std::string otherStr = RandomPathString(random);
+		Path path = str, other = otherStr;
+		RegexPath refPath = str, refOther = otherStr;
+
+		const bool bEquivalent = Path::isNode(str) == RegexPath::isNode(str)
+			&& path.str() == refPath.path
+			&& path.normalize().str() == refPath.normalize().path
+			&& path.normalize().normalize().str() == refPath.normalize().path
+			&& path.absolute().str() == refPath.absolute().path
+			&& path.relative().str() == refPath.relative().path
+			&& (path / other).str() == (refPath / refOther).path
+			&& (path.normalize() / other).str() == (refPath.normalize() / refOther).path
+			&& path.startsWith(other) == refPath.startsWith(refOther)
+			&& (path == other) == (refPath == refOther)
+			&& (path.normalize() == other) == (refPath == refOther)
+			&& path == path.absolute()
+			&& path.hash() == path.relative().hash()
+			&& (!(path == other) || path.hash() == other.hash());
+		if (!bEquivalent) {
+			AddError(FString::Printf(TEXT("Path '%s' with other path '%s' differs from the regex implementation"), UTF8_TO_TCHAR(str.c_str()), UTF8_TO_TCHAR(otherStr.c_str())));
+		}
+	}
+	return !HasAnyErrors();
+}
+
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+	struct CountedObject : public ReferenceCounted {
+		static constexpr uint32_t AliveMagic = 0xA11CE;
+		static constexpr uint32_t DeadMagic = 0xDEAD;
+		static std::atomic<int> Alive;
+		// accesses of deleted objects and objects deleted more than once
+		static std::atomic<int> Failures;
+
+		uint32_t magic = AliveMagic;
+
+		CountedObject() { ++Alive; }
+		virtual ~CountedObject() {
+			if (magic != AliveMagic) ++Failures;
+			magic = DeadMagic;
+			--Alive;
+		}
+
+		static void checkAlive(const SRef<CountedObject>& ref) {
+			if (ref.isValid() && ref->magic != AliveMagic) ++Failures;
+		}
+	};
+
+	std::atomic<int> CountedObject::Alive = 0;
+	std::atomic<int> CountedObject::Failures = 0;
+}
+
+/*
+* copies, releases and locks shared and weak references on multiple threads at once
+* and checks that every object gets deleted exactly once and never gets accessed after deletion
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINFileSystemReferenceCountTest, "FicsItNetworks.FileSystem.ReferenceCount", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFINFileSystemReferenceCountTest::RunTest(const FString& Parameters) {
+	constexpr int Rounds = 8;
+	constexpr int Threads = 4;
+	constexpr int Objects = 16;
+	constexpr int Operations = 2000;
+
+	CountedObject::Failures = 0;
+	for (int round = 0; round < Rounds; ++round) {
+		std::vector<SRef<CountedObject>> objects;
+		for (int i = 0; i < Objects; ++i) objects.push_back(new CountedObject());
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < Threads; ++t) {
+			std::vector<SRef<CountedObject>> strong(objects.begin(), objects.end());
+			std::vector<WRef<CountedObject>> weak(objects.begin(), objects.end());
+			threads.emplace_back([strong = std::move(strong), weak = std::move(weak), seed = round * Threads + t]() mutable {
+				std::mt19937 random(seed);
+				for (int i = 0; i < Operations; ++i) {
+					size_t index = random() % strong.size();
+					switch (random() % 5) {
+					case 0: {
+						SRef<CountedObject> copy = strong[index];
+						CountedObject::checkAlive(copy);
+						break;
+					} case 1: {
+						WRef<CountedObject> copy = strong[index];
+						SRef<CountedObject> locked = copy;
+						CountedObject::checkAlive(locked);
+						break;
+					} case 2: {
+						SRef<CountedObject> locked = weak[index];
+						CountedObject::checkAlive(locked);
+						break;
+					} case 3: {
+						WRef<CountedObject> copy = weak[index];
+						weak[index] = copy;
+						break;
+					} case 4:
+						// dropping the strong references races with the other threads locking their weak references
+						strong[index] = nullptr;
+						break;
+					}
+				}
+			});
+		}
+		objects.clear();
+		for (std::thread& thread : threads) thread.join();
+		threads.clear();
+		TestEqual(TEXT("Objects alive after all references got released"), CountedObject::Alive.load(), 0);
+	}
+	TestEqual(TEXT("Accesses of deleted objects"), CountedObject::Failures.load(), 0);
+	return !HasAnyErrors();
+}
+
+#endif
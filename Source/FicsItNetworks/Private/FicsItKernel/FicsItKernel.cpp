@@ -195,20 +195,28 @@ void UFINKernelSystem::RemoveDrive(AFINFileSystemState* InDrive) {
 }
 
 void UFINKernelSystem::PushFuture(TSharedPtr<TFINDynamicStruct<FFINFuture>> InFuture) {
-	FutureQueue.Enqueue(InFuture);
+	FScopeLock Lock(&FutureQueueMutex);
+	FutureQueue.Add(InFuture);
 }
 
 void UFINKernelSystem::HandleFutures() {
-	while (!FutureQueue.IsEmpty()) {
-		TSharedPtr<TFINDynamicStruct<FFINFuture>> Future;
-		FutureQueue.Peek(Future);
-		FutureQueue.Pop();
+	// take the whole batch at once, so the queue is not locked while executing and stays available to the processor
+	TArray<TSharedPtr<TFINDynamicStruct<FFINFuture>>> Futures;
+	{
+		FScopeLock Lock(&FutureQueueMutex);
+		if (FutureQueue.Num() < 1) return;
+		Swap(Futures, FutureQueue);
+	}
+	bool bResolved = false;
+	for (const TSharedPtr<TFINDynamicStruct<FFINFuture>>& Future : Futures) {
 		try {
 			(*Future)->Execute();
+			bResolved = true;
 		} catch (FFINException e) {
 			Crash(MakeShared<FFINKernelCrash>(e.GetMessage())); // TODO: Maybe add a way to make these future crashes catchable in f.e. Lua using protected calls
 		}
 	}
+	if (bResolved && Processor) Processor->FuturesResolved();
 }
 
 TMap<AFINFileSystemState*, CodersFileSystem::SRef<CodersFileSystem::Device>> UFINKernelSystem::GetDrives() const {
@@ -15,7 +15,14 @@ void UFINKernelNetworkController::Serialize(FStructuredArchive::FRecord Record)
 	if (AFINComputerSubsystem::GetComputerSubsystem(this)->Version < FINKernelRefactor) return;
 	
 	// serialize signals
-	int32 SignalCount = SignalQueue.Num();
+	// signal receiving is locked while saving, so the queue can be safely snapshotted here
+	TArray<TPair<FFINSignalData, FFINNetworkTrace>> Signals;
+	if (Record.GetUnderlyingArchive().IsSaving()) {
+		SignalQueue.ForEach([&Signals](const TPair<FFINSignalData, FFINNetworkTrace>& Signal) {
+			Signals.Add(Signal);
+		});
+	}
+	int32 SignalCount = Signals.Num();
 	FStructuredArchive::FArray SignalListRecord = Record.EnterArray(SA_FIELD_NAME(TEXT("Signals")), SignalCount);
 	for (int i = 0; i < SignalCount; ++i) {
 		FStructuredArchive::FRecord SignalRecord = SignalListRecord.EnterElement().EnterRecord();
@@ -23,7 +30,7 @@ void UFINKernelNetworkController::Serialize(FStructuredArchive::FRecord Record)
 		FFINSignalData Signal;
 		FFINNetworkTrace Trace;
 		if (SignalRecord.GetUnderlyingArchive().IsSaving()) {
-			const TTuple<FFINSignalData, FFINNetworkTrace>& SignalData = SignalQueue[i];
+			const TTuple<FFINSignalData, FFINNetworkTrace>& SignalData = Signals[i];
 			Signal = SignalData.Key;
 			Trace = SignalData.Value;
 		}
@@ -32,7 +39,7 @@ void UFINKernelNetworkController::Serialize(FStructuredArchive::FRecord Record)
 		SignalRecord.EnterField(SA_FIELD_NAME(TEXT("Trace"))) << Trace;
 		
 		if (SignalRecord.GetUnderlyingArchive().IsLoading()) {
-			SignalQueue.Add(TPair<FFINSignalData, FFINNetworkTrace>{Signal, Trace});
+			SignalQueue.Push(TPair<FFINSignalData, FFINNetworkTrace>{MoveTemp(Signal), MoveTemp(Trace)});
 		}
 	}
 }
@@ -66,27 +73,26 @@ void UFINKernelNetworkController::HandleSignal(const FFINSignalData& signal, con
 }
 
 FFINSignalData UFINKernelNetworkController::PopSignal(FFINNetworkTrace& OutSender) {
-	if (GetSignalCount() < 1) return FFINSignalData();
-	FScopeLock Lock(&MutexSignals);
-	const TTuple<FFINSignalData, FFINNetworkTrace> Signal = SignalQueue[0];
-	SignalQueue.RemoveAt(0);
-	OutSender = Signal.Value;
-	return Signal.Key;
+	TPair<FFINSignalData, FFINNetworkTrace> Signal;
+	if (!SignalQueue.Pop(Signal)) return FFINSignalData();
+	OutSender = MoveTemp(Signal.Value);
+	return MoveTemp(Signal.Key);
+}
+
+int32 UFINKernelNetworkController::PopSignals(TArray<TPair<FFINSignalData, FFINNetworkTrace>>& OutSignals, int32 InMaxCount) {
+	return SignalQueue.PopMany(OutSignals, InMaxCount);
 }
 
 void UFINKernelNetworkController::PushSignal(const FFINSignalData& signal, const FFINNetworkTrace& sender) {
-	FScopeLock Lock(&MutexSignals);
-	if (GetSignalCount() >= MaxSignalCount || bLockSignalReceiving) return;
-	SignalQueue.Add(TPair<FFINSignalData, FFINNetworkTrace>{signal, sender});
+	if (bLockSignalReceiving) return;
+	SignalQueue.Push(TPair<FFINSignalData, FFINNetworkTrace>{signal, sender});
 }
 
 void UFINKernelNetworkController::ClearSignals() {
-	FScopeLock Lock(&MutexSignals);
 	SignalQueue.Empty();
 }
 
-size_t UFINKernelNetworkController::GetSignalCount() {
-	FScopeLock Lock(&MutexSignals);
+uint64 UFINKernelNetworkController::GetSignalCount() {
 	return SignalQueue.Num();
 }
 
@@ -108,13 +114,8 @@ TSet<FFINNetworkTrace> UFINKernelNetworkController::GetComponentByNick(const FSt
 TSet<FFINNetworkTrace> UFINKernelNetworkController::GetComponentByClass(UClass* InClass, bool bRedirect) const {
 	if (!Component.GetObject()->Implements<UFINNetworkCircuitNode>()) return TSet<FFINNetworkTrace>();
 	TSet<FFINNetworkTrace> outComps;
-	TSet<UObject*> Comps = IFINNetworkCircuitNode::Execute_GetCircuit(Component.GetObject())->GetComponents();
+	TSet<UObject*> Comps = IFINNetworkCircuitNode::Execute_GetCircuit(Component.GetObject())->FindComponentsByClass(InClass, bRedirect, Component);
 	for (UObject* Comp : Comps) {
-		if (bRedirect) {
-			UObject* RedirectedComp = UFINNetworkUtils::RedirectIfPossible(FFINNetworkTrace(Comp)).Get();
-			if (!RedirectedComp->IsA(InClass)) continue;
-		} else if (!Comp->IsA(InClass)) continue;
-		if (!IFINNetworkComponent::Execute_AccessPermitted(Comp, IFINNetworkComponent::Execute_GetID(Component.GetObject()))) continue;
 		outComps.Add(FFINNetworkTrace(Component.GetObject()) / Comp);
 	}
 	return outComps;
@@ -5,6 +5,7 @@
 #include "Network/FINNetworkConnectionComponent.h"
 #include "Network/FINNetworkAdapter.h"
 #include "Network/FINNetworkCable.h"
+#include "Network/FINNetworkTrace.h"
 #include "ModuleSystem/FINModuleSystemPanel.h"
 #include "FicsItKernel/FicsItFS/Library/Tests.h"
 #include "AssetRegistryModule.h"
@@ -187,6 +188,11 @@ void FFicsItNetworksModule::StartupModule(){
 	CodersFileSystem::Tests::TestPath();
 	
 	GameStart = FDateTime::Now();
+
+	// objects referenced by traces may change in any way during a frame, so every trace gets validated again once per frame
+	FWorldDelegates::OnWorldTickStart.AddLambda([](UWorld* World, ELevelTick TickType, float DeltaSeconds) {
+		if (World->IsGameWorld()) FFINNetworkTrace::InvalidateValidationCache();
+	});
 	
 	TArray<FCoreRedirect> redirects;
 	redirects.Add(FCoreRedirect{ECoreRedirectFlags::Type_Class, TEXT("/Script/FicsItNetworks.FINNetworkConnector"), TEXT("/Script/FicsItNetworks.FINAdvancedNetworkConnectionComponent")});
@@ -308,18 +314,18 @@ void FFicsItNetworksModule::StartupModule(){
 			}
 		});
 
-		// Wireless - Recalculate network topology when radar tower is created or destroyed
+		// Wireless - Update network topology when radar tower is created or destroyed
 		SUBSCRIBE_METHOD_VIRTUAL_AFTER(AFGBuildableRadarTower::BeginPlay, (void*)GetDefault<AFGBuildableRadarTower>(), [](AActor* self) {
 			if (self->HasAuthority()) {
-				UE_LOG(LogFicsItNetworks, Display, TEXT("[Wireless] Radar tower Created, recalculating network topology"));
-				AFINWirelessSubsystem::Get(self->GetWorld())->RecalculateWirelessConnections();
+				UE_LOG(LogFicsItNetworks, Display, TEXT("[Wireless] Radar tower Created, updating network topology"));
+				AFINWirelessSubsystem::Get(self->GetWorld())->AddRadarTower(Cast<AFGBuildableRadarTower>(self));
 			}
 		});
 		
 		SUBSCRIBE_METHOD_VIRTUAL_AFTER(AFGBuildableRadarTower::EndPlay, (void*)GetDefault<AFGBuildableRadarTower>(), [](AActor* self, EEndPlayReason::Type Reason) {
 			if (Reason == EEndPlayReason::Destroyed && self->HasAuthority()) {
-				UE_LOG(LogFicsItNetworks, Display, TEXT("[Wireless] Radar tower Destroyed, recalculating network topology"));
-				AFINWirelessSubsystem::Get(self->GetWorld())->RecalculateWirelessConnections();
+				UE_LOG(LogFicsItNetworks, Display, TEXT("[Wireless] Radar tower Destroyed, updating network topology"));
+				AFINWirelessSubsystem::Get(self->GetWorld())->RemoveRadarTower(Cast<AFGBuildableRadarTower>(self));
 			}
 		});
 
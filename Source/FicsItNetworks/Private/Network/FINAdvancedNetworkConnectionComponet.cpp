@@ -26,6 +26,8 @@ void UFINAdvancedNetworkConnectionComponent::BeginPlay() {
 			if (!Circuit) {
 				Circuit = GetWorld()->SpawnActor<AFINNetworkCircuit>();
 				Circuit->Recalculate(this);
+			} else {
+				Circuit->UpdateNode(this);
 			}
 		}
 	}
@@ -64,6 +66,7 @@ FString UFINAdvancedNetworkConnectionComponent::GetNick_Implementation() const {
 
 void UFINAdvancedNetworkConnectionComponent::SetNick_Implementation(const FString& NewNick) {
 	Nick = NewNick;
+	if (Circuit) Circuit->UpdateNode(this);
 }
 
 bool UFINAdvancedNetworkConnectionComponent::HasNick_Implementation(const FString& inNick) {
@@ -1,3 +0,0 @@
-#include "Network/FINFuture.h"
-
-FCriticalSection FFINFutureReflection::Mutex;
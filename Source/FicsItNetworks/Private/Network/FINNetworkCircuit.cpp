@@ -2,19 +2,133 @@
 
 #include "Engine/World.h"
 #include "Net/UnrealNetwork.h"
+#include "Network/FINNetworkMessageInterface.h"
+#include "Network/FINNetworkTrace.h"
+#include "Network/FINNetworkUtils.h"
 
-void AFINNetworkCircuit::AddNodeRecursive(TArray<TScriptInterface<IFINNetworkCircuitNode>>& Added, TScriptInterface<IFINNetworkCircuitNode> Add) {
-	if (Add.GetObject() && !Added.Contains(Add)) {
-		Added.Add(Add);
-		Nodes.AddUnique(Add.GetObject());
-		IFINNetworkCircuitNode::Execute_SetCircuit(Add.GetObject(), this);
-		TSet<UObject*> ConNodes = IFINNetworkCircuitNode::Execute_GetConnected(Add.GetObject());
-		for (UObject* Node : ConNodes) {
-			AddNodeRecursive(Added, Node);
+void AFINNetworkCircuit::AddNodesConnectedTo(UObject* Start) {
+	if (!Start) return;
+	TSet<UObject*> Added;
+	TArray<UObject*> ToVisit;
+	Added.Add(Start);
+	ToVisit.Push(Start);
+	while (ToVisit.Num() > 0) {
+		UObject* Node = ToVisit.Pop(false);
+		AddNode(Node);
+		IFINNetworkCircuitNode::Execute_SetCircuit(Node, this);
+		for (UObject* Connected : IFINNetworkCircuitNode::Execute_GetConnected(Node)) {
+			if (!Connected) continue;
+			bool bAlreadyAdded;
+			Added.Add(Connected, &bAlreadyAdded);
+			if (!bAlreadyAdded) ToVisit.Push(Connected);
 		}
 	}
 }
 
+void AFINNetworkCircuit::AddNode(UObject* Node) {
+	if (!Node || IndexedNodes.Contains(Node)) return;
+	IndexNode(Node, Nodes.Add(Node));
+}
+
+void AFINNetworkCircuit::RemoveNode(UObject* Node) {
+	const FFINNetworkCircuitIndexEntry* Entry = IndexedNodes.Find(Node);
+	if (!Entry) return;
+	const int32 NodeIndex = Entry->NodeIndex;
+	UnindexNode(Node);
+	FFINNetworkTrace::InvalidateValidationCache();
+	Nodes.RemoveAtSwap(NodeIndex, 1, false);
+	if (Nodes.IsValidIndex(NodeIndex)) {
+		FFINNetworkCircuitIndexEntry* Moved = IndexedNodes.Find(Nodes[NodeIndex]);
+		if (Moved) Moved->NodeIndex = NodeIndex;
+	}
+}
+
+void AFINNetworkCircuit::ClearNodes() {
+	FFINNetworkTrace::InvalidateValidationCache();
+	Nodes.Empty();
+	IndexedNodes.Empty();
+	ComponentIndex.Empty();
+	IDIndex.Empty();
+	NickIndex.Empty();
+	ClassIndex.Empty();
+	RedirectClassIndex.Empty();
+	MessageEndpointIndex.Empty();
+	PendingIDIndex.Empty();
+}
+
+void AFINNetworkCircuit::IndexNode(UObject* Node, int32 NodeIndex) {
+	FFINNetworkCircuitIndexEntry& Entry = IndexedNodes.Add(Node);
+	Entry.NodeIndex = NodeIndex;
+	if (!Node->Implements<UFINNetworkComponent>()) return;
+	Entry.bIsComponent = true;
+	ComponentIndex.Add(Node);
+	if (Cast<IFINNetworkMessageInterface>(Node)) MessageEndpointIndex.Add(Node);
+
+	Entry.ID = IFINNetworkComponent::Execute_GetID(Node);
+	if (Entry.ID.IsValid()) {
+		IDIndex.Add(Entry.ID, Node);
+	} else {
+		PendingIDIndex.Add(Node);
+	}
+
+	IFINNetworkComponent::Execute_GetNick(Node).ParseIntoArray(Entry.NickTokens, TEXT(" "), true);
+	for (const FString& Token : Entry.NickTokens) {
+		NickIndex.FindOrAdd(Token).Add(Node);
+	}
+
+	Entry.Class = Node->GetClass();
+	ClassIndex.FindOrAdd(Entry.Class).Add(Node);
+	UObject* Redirect = UFINNetworkUtils::RedirectIfPossible(FFINNetworkTrace(Node)).Get();
+	Entry.RedirectClass = Redirect ? Redirect->GetClass() : Entry.Class;
+	RedirectClassIndex.FindOrAdd(Entry.RedirectClass).Add(Node);
+}
+
+void AFINNetworkCircuit::UnindexNode(UObject* Node) {
+	FFINNetworkCircuitIndexEntry Entry;
+	if (!IndexedNodes.RemoveAndCopyValue(Node, Entry) || !Entry.bIsComponent) return;
+	ComponentIndex.Remove(Node);
+	MessageEndpointIndex.Remove(Node);
+
+	const TWeakObjectPtr<UObject>* IDNode = IDIndex.Find(Entry.ID);
+	if (IDNode && *IDNode == Node) IDIndex.Remove(Entry.ID);
+	PendingIDIndex.Remove(Node);
+
+	for (const FString& Token : Entry.NickTokens) {
+		TSet<TWeakObjectPtr<UObject>>* NickNodes = NickIndex.Find(Token);
+		if (!NickNodes) continue;
+		NickNodes->Remove(Node);
+		if (NickNodes->Num() < 1) NickIndex.Remove(Token);
+	}
+
+	TSet<TWeakObjectPtr<UObject>>* ClassNodes = ClassIndex.Find(Entry.Class);
+	if (ClassNodes) ClassNodes->Remove(Node);
+	TSet<TWeakObjectPtr<UObject>>* RedirectClassNodes = RedirectClassIndex.Find(Entry.RedirectClass);
+	if (RedirectClassNodes) RedirectClassNodes->Remove(Node);
+}
+
+void AFINNetworkCircuit::IndexPendingIDs() {
+	if (PendingIDIndex.Num() < 1) return;
+	TArray<TWeakObjectPtr<UObject>> Pending = PendingIDIndex.Array();
+	for (const TWeakObjectPtr<UObject>& Node : Pending) {
+		UObject* Obj = Node.Get();
+		if (!Obj) {
+			PendingIDIndex.Remove(Node);
+			continue;
+		}
+		const FGuid ID = IFINNetworkComponent::Execute_GetID(Obj);
+		if (!ID.IsValid()) continue;
+		PendingIDIndex.Remove(Node);
+		IndexedNodes.FindChecked(Node).ID = ID;
+		IDIndex.Add(ID, Node);
+	}
+}
+
+void AFINNetworkCircuit::OnRep_Nodes() {
+	TArray<UObject*> RepNodes = Nodes;
+	ClearNodes();
+	for (UObject* Node : RepNodes) AddNode(Node);
+}
+
 AFINNetworkCircuit::AFINNetworkCircuit() {
 	bReplicates = true;
 	bAlwaysRelevant = true;
@@ -61,29 +175,37 @@ AFINNetworkCircuit* AFINNetworkCircuit::operator+(AFINNetworkCircuit* Circuit) {
 		if (Obj) IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Obj, 0, FromNodes);
 	}
 
-	for (const TSoftObjectPtr<UObject>& Node : From->Nodes) To->Nodes.AddUnique(Node.Get() );
+	for (const TSoftObjectPtr<UObject>& Node : From->Nodes) To->AddNode(Node.Get());
 
 	return To;
 }
 
 void AFINNetworkCircuit::Recalculate(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
-	Nodes.Empty();
+	ClearNodes();
+
+	AddNodesConnectedTo(Node.GetObject());
+}
 
-	TArray<TScriptInterface<IFINNetworkCircuitNode>> Added;
-	AddNodeRecursive(Added, Node);
+void AFINNetworkCircuit::UpdateNode(UObject* Node) {
+	const FFINNetworkCircuitIndexEntry* Entry = IndexedNodes.Find(Node);
+	if (!Node || !Entry) return;
+	const int32 NodeIndex = Entry->NodeIndex;
+	UnindexNode(Node);
+	FFINNetworkTrace::InvalidateValidationCache();
+	IndexNode(Node, NodeIndex);
 }
 
 bool AFINNetworkCircuit::HasNode(const TScriptInterface<IFINNetworkCircuitNode>& Node) {
-	return Nodes.Find(Node.GetObject()) != INDEX_NONE;
+	return IndexedNodes.Contains(Node.GetObject());
 }
 
 TScriptInterface<IFINNetworkComponent> AFINNetworkCircuit::FindComponent(const FGuid& ID, const TScriptInterface<IFINNetworkComponent>& Requester) {
 	FGuid ReqID = (Requester) ? IFINNetworkComponent::Execute_GetID(Requester.GetObject()) : FGuid();
-	for (const TSoftObjectPtr<UObject>& node : Nodes) {
-		UObject* Obj = node.Get();
-		if (Obj && Obj->Implements<UFINNetworkComponent>() && IFINNetworkComponent::Execute_GetID(Obj) == ID && IFINNetworkComponent::Execute_AccessPermitted(Obj, ReqID)) {
-			return Obj;
-		}
+	IndexPendingIDs();
+	const TWeakObjectPtr<UObject>* Node = IDIndex.Find(ID);
+	UObject* Obj = Node ? Node->Get() : nullptr;
+	if (Obj && IFINNetworkComponent::Execute_AccessPermitted(Obj, ReqID)) {
+		return Obj;
 	}
 
 	return nullptr;
@@ -92,9 +214,45 @@ TScriptInterface<IFINNetworkComponent> AFINNetworkCircuit::FindComponent(const F
 TSet<UObject*> AFINNetworkCircuit::FindComponentsByNick(const FString& Nick, const TScriptInterface<IFINNetworkComponent>& Requester) {
 	FGuid ReqID = (Requester) ? IFINNetworkComponent::Execute_GetID(Requester.GetObject()) : FGuid();
 	TSet<UObject*> Comps;
-	for (const TSoftObjectPtr<UObject>& Node : Nodes) {
+
+	// search only the components of the least used nick token, the others get checked per component
+	TArray<FString> Tokens;
+	Nick.ParseIntoArray(Tokens, TEXT(" "), true);
+	const TSet<TWeakObjectPtr<UObject>>* Candidates = &ComponentIndex;
+	for (const FString& Token : Tokens) {
+		const TSet<TWeakObjectPtr<UObject>>* TokenNodes = NickIndex.Find(Token);
+		if (!TokenNodes) return Comps;
+		if (Candidates == &ComponentIndex || TokenNodes->Num() < Candidates->Num()) Candidates = TokenNodes;
+	}
+
+	for (const TWeakObjectPtr<UObject>& Node : *Candidates) {
 		UObject* Obj = Node.Get();
-		if (Obj && Obj->Implements<UFINNetworkComponent>() && IFINNetworkComponent::Execute_HasNick(Obj, Nick) && IFINNetworkComponent::Execute_AccessPermitted(Obj, ReqID)) Comps.Add(Obj);
+		if (!Obj) continue;
+		const FFINNetworkCircuitIndexEntry& Entry = IndexedNodes.FindChecked(Node);
+		bool bHasNick = true;
+		for (const FString& Token : Tokens) {
+			if (!Entry.NickTokens.Contains(Token)) {
+				bHasNick = false;
+				break;
+			}
+		}
+		if (bHasNick && IFINNetworkComponent::Execute_AccessPermitted(Obj, ReqID)) Comps.Add(Obj);
+	}
+
+	return Comps;
+}
+
+TSet<UObject*> AFINNetworkCircuit::FindComponentsByClass(UClass* Class, bool bRedirect, const TScriptInterface<IFINNetworkComponent>& Requester) {
+	FGuid ReqID = (Requester) ? IFINNetworkComponent::Execute_GetID(Requester.GetObject()) : FGuid();
+	TSet<UObject*> Comps;
+	if (!Class) return Comps;
+
+	for (const TPair<UClass*, TSet<TWeakObjectPtr<UObject>>>& ClassNodes : bRedirect ? RedirectClassIndex : ClassIndex) {
+		if (!ClassNodes.Key->IsChildOf(Class)) continue;
+		for (const TWeakObjectPtr<UObject>& Node : ClassNodes.Value) {
+			UObject* Obj = Node.Get();
+			if (Obj && IFINNetworkComponent::Execute_AccessPermitted(Obj, ReqID)) Comps.Add(Obj);
+		}
 	}
 
 	return Comps;
@@ -102,49 +260,43 @@ TSet<UObject*> AFINNetworkCircuit::FindComponentsByNick(const FString& Nick, con
 
 TSet<UObject*> AFINNetworkCircuit::GetComponents() {
 	TSet<UObject*> Comps;
-	for (const TSoftObjectPtr<UObject>& Node : Nodes) {
+	Comps.Reserve(ComponentIndex.Num());
+	for (const TWeakObjectPtr<UObject>& Node : ComponentIndex) {
 		UObject* Obj = Node.Get();
-		if (Obj && Obj->Implements<UFINNetworkComponent>()) Comps.Add(Obj);
+		if (Obj) Comps.Add(Obj);
 	}
 	return Comps;
 }
 
+int32 AFINNetworkCircuit::ForEachMessageEndpoint(bool bRoutersOnly, TFunctionRef<void(IFINNetworkMessageInterface*)> Func) {
+	int32 Count = 0;
+	for (const TWeakObjectPtr<UObject>& Node : MessageEndpointIndex) {
+		IFINNetworkMessageInterface* Endpoint = Cast<IFINNetworkMessageInterface>(Node.Get());
+		if (!Endpoint || (bRoutersOnly && !Endpoint->IsNetworkMessageRouter())) continue;
+		Func(Endpoint);
+		++Count;
+	}
+	return Count;
+}
+
 bool AFINNetworkCircuit::IsNodeConnected(const TScriptInterface<IFINNetworkCircuitNode>& Start, const TScriptInterface<IFINNetworkCircuitNode>& Node) {
 	TSet<UObject*> Searched;
 	return IsNodeConnected_Internal(Start, Node, Searched);
 }
 
 void AFINNetworkCircuit::DisconnectNodes(UObject* WorldContext, const TScriptInterface<IFINNetworkCircuitNode>& A, const TScriptInterface<IFINNetworkCircuitNode>& B) {
-	if (!IsNodeConnected(A, B)) {
-		AFINNetworkCircuit* CircuitA = IFINNetworkCircuitNode::Execute_GetCircuit(A.GetObject());
-		AFINNetworkCircuit* CircuitB = IFINNetworkCircuitNode::Execute_GetCircuit(B.GetObject());
-		if (CircuitA != CircuitB) return;
-		
-		CircuitA = WorldContext->GetWorld()->SpawnActor<AFINNetworkCircuit>();
-		IFINNetworkCircuitNode::Execute_SetCircuit(A.GetObject(), CircuitA);
-		CircuitA->Recalculate(A);
-
-		
-		TSet<UObject*> NodesA;
-		for (const TSoftObjectPtr<UObject>& Node : CircuitA->Nodes) {
-			UObject* Obj = Node.Get();
-			if (Obj) NodesA.Add(Obj);
-		}
-		TSet<UObject*> NodesB;
-		for (const TSoftObjectPtr<UObject>& Node : CircuitB->Nodes) {
-			UObject* Obj = Node.Get();
-			if (Obj) NodesB.Add(Obj);
-		}
+	AFINNetworkCircuit* Circuit = IFINNetworkCircuitNode::Execute_GetCircuit(A.GetObject());
+	if (!Circuit || Circuit != IFINNetworkCircuitNode::Execute_GetCircuit(B.GetObject())) return;
 
-		for (const TSoftObjectPtr<UObject>& Node : CircuitB->Nodes) {
-			if (CircuitB->Nodes.Contains(Node)) continue;
-			IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Node.Get(), 1, NodesA);
-		}
-		CircuitB->Recalculate(B);
-		for (const TSoftObjectPtr<UObject>& Node : CircuitA->Nodes) {
-			if (CircuitA->Nodes.Contains(Node)) continue;
-			IFINNetworkCircuitNode::Execute_NotifyNetworkUpdate(Node.Get(), 1, NodesB);
-		}
+	TSet<UObject*> Separated;
+	if (!FindSeparatedNodes(A.GetObject(), B.GetObject(), Separated)) return;
+
+	// move the smaller side into a new circuit, the bigger side stays untouched
+	AFINNetworkCircuit* NewCircuit = WorldContext->GetWorld()->SpawnActor<AFINNetworkCircuit>();
+	for (UObject* Node : Separated) {
+		Circuit->RemoveNode(Node);
+		NewCircuit->AddNode(Node);
+		IFINNetworkCircuitNode::Execute_SetCircuit(Node, NewCircuit);
 	}
 }
 
@@ -183,3 +335,32 @@ bool AFINNetworkCircuit::IsNodeConnected_Internal(const TScriptInterface<IFINNet
 
 	return false;
 }
+
+bool AFINNetworkCircuit::FindSeparatedNodes(UObject* A, UObject* B, TSet<UObject*>& OutSeparated) {
+	if (!A || !B || A == B) return false;
+
+	TSet<UObject*> Visited[2];
+	TArray<UObject*> ToVisit[2];
+	Visited[0].Add(A);
+	ToVisit[0].Push(A);
+	Visited[1].Add(B);
+	ToVisit[1].Push(B);
+
+	while (true) {
+		for (int Side = 0; Side < 2; ++Side) {
+			if (ToVisit[Side].Num() < 1) {
+				// this side is fully explored without meeting the other side
+				OutSeparated = MoveTemp(Visited[Side]);
+				return true;
+			}
+			UObject* Node = ToVisit[Side].Pop(false);
+			for (UObject* Connected : IFINNetworkCircuitNode::Execute_GetConnected(Node)) {
+				if (!Connected) continue;
+				if (Visited[1-Side].Contains(Connected)) return false;
+				bool bAlreadyVisited;
+				Visited[Side].Add(Connected, &bAlreadyVisited);
+				if (!bAlreadyVisited) ToVisit[Side].Push(Connected);
+			}
+		}
+	}
+}
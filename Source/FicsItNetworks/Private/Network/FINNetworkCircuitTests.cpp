@@ -0,0 +1,337 @@
+#include "Network/FINNetworkCircuitTestNode.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Network/FINNetworkCircuit.h"
+#include "Network/FINNetworkTrace.h"
+#include "Network/FINNetworkUtils.h"
+
+TSet<UObject*> UFINNetworkCircuitTestConnector::GetConnected_Implementation() const {
+	return Connected;
+}
+
+AFINNetworkCircuit* UFINNetworkCircuitTestConnector::GetCircuit_Implementation() const {
+	return Circuit;
+}
+
+void UFINNetworkCircuitTestConnector::SetCircuit_Implementation(AFINNetworkCircuit* InCircuit) {
+	Circuit = InCircuit;
+}
+
+void UFINNetworkCircuitTestConnector::NotifyNetworkUpdate_Implementation(int32 Type, const TSet<UObject*>& Nodes) {}
+
+FGuid UFINNetworkCircuitTestNode::GetID_Implementation() const {
+	return ID;
+}
+
+FString UFINNetworkCircuitTestNode::GetNick_Implementation() const {
+	return Nick;
+}
+
+void UFINNetworkCircuitTestNode::SetNick_Implementation(const FString& InNick) {
+	Nick = InNick;
+	if (Circuit) Circuit->UpdateNode(this);
+}
+
+bool UFINNetworkCircuitTestNode::HasNick_Implementation(const FString& InNick) {
+	return HasNickByNick(InNick, Execute_GetNick(this));
+}
+
+UObject* UFINNetworkCircuitTestNode::GetInstanceRedirect_Implementation() {
+	return Redirect;
+}
+
+bool UFINNetworkCircuitTestNode::AccessPermitted_Implementation(FGuid InID) const {
+	return true;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+	const TCHAR* TestNicks[] = {TEXT(""), TEXT("a"), TEXT("b"), TEXT("a b"), TEXT("b c"), TEXT("c  a"), TEXT("B"), TEXT("d a b")};
+	const TCHAR* TestQueries[] = {TEXT(""), TEXT("a"), TEXT("A"), TEXT("b"), TEXT("a b"), TEXT("c a"), TEXT("d"), TEXT("a e")};
+
+	/**
+	 * Bare game world the synthetic circuits get spawned in.
+	 */
+	struct FFINCircuitTestWorld {
+		UWorld* World;
+
+		FFINCircuitTestWorld() {
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+		}
+
+		~FFINCircuitTestWorld() {
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	};
+
+	/**
+	 * The lookups like the circuit did them before it had indices, by walking all nodes of the circuit.
+	 * Used as reference for the indices and as baseline for the benchmark.
+	 */
+	namespace Linear {
+		UObject* FindComponent(const TArray<UObject*>& Nodes, const FGuid& ID) {
+			for (UObject* Obj : Nodes) {
+				if (Obj->Implements<UFINNetworkComponent>() && IFINNetworkComponent::Execute_GetID(Obj) == ID && IFINNetworkComponent::Execute_AccessPermitted(Obj, FGuid())) return Obj;
+			}
+			return nullptr;
+		}
+
+		TSet<UObject*> FindComponentsByNick(const TArray<UObject*>& Nodes, const FString& Nick) {
+			TSet<UObject*> Comps;
+			for (UObject* Obj : Nodes) {
+				if (Obj->Implements<UFINNetworkComponent>() && IFINNetworkComponent::Execute_HasNick(Obj, Nick) && IFINNetworkComponent::Execute_AccessPermitted(Obj, FGuid())) Comps.Add(Obj);
+			}
+			return Comps;
+		}
+
+		TSet<UObject*> FindComponentsByClass(const TArray<UObject*>& Nodes, UClass* Class, bool bRedirect) {
+			TSet<UObject*> Comps;
+			for (UObject* Obj : Nodes) {
+				if (!Obj->Implements<UFINNetworkComponent>()) continue;
+				UObject* Typed = bRedirect ? UFINNetworkUtils::RedirectIfPossible(FFINNetworkTrace(Obj)).Get() : Obj;
+				if (Typed && Typed->IsA(Class) && IFINNetworkComponent::Execute_AccessPermitted(Obj, FGuid())) Comps.Add(Obj);
+			}
+			return Comps;
+		}
+	}
+
+	bool SetsEqual(const TSet<UObject*>& A, const TSet<UObject*>& B) {
+		return A.Num() == B.Num() && A.Includes(B);
+	}
+
+	UFINNetworkCircuitTestConnector* AsTestNode(UObject* Node) {
+		return CastChecked<UFINNetworkCircuitTestConnector>(Node);
+	}
+
+	/**
+	 * Builds synthetic circuits out of test nodes
+	 * and changes them only through the public circuit functions like the game does.
+	 */
+	struct FFINCircuitTestNetwork {
+		UWorld* World;
+		FRandomStream Random;
+		TArray<UObject*> Nodes;
+		TArray<TPair<UObject*, UObject*>> Edges;
+
+		FFINCircuitTestNetwork(UWorld* World, int32 Seed) : World(World), Random(Seed) {}
+
+		UObject* CreateNode() {
+			UObject* Node;
+			const int32 Kind = Random.RandRange(0, 9);
+			if (Kind == 0) {
+				Node = NewObject<UFINNetworkCircuitTestConnector>(World);
+			} else {
+				UFINNetworkCircuitTestNode* Comp = (Kind < 4) ? NewObject<UFINNetworkCircuitTestNodeVariant>(World) : NewObject<UFINNetworkCircuitTestNode>(World);
+				// some components get their id later on, like components loaded before their id got created
+				if (Random.RandRange(0, 9) > 0) Comp->ID = FGuid::NewGuid();
+				Comp->Nick = TestNicks[Random.RandRange(0, UE_ARRAY_COUNT(TestNicks)-1)];
+				if (Random.RandRange(0, 4) == 0) Comp->Redirect = NewObject<UFINNetworkCircuitTestConnector>(World);
+				Node = Comp;
+			}
+			Nodes.Add(Node);
+			return Node;
+		}
+
+		/**
+		 * Creates a tree of the given amount of nodes, connecting every node as soon as it got created.
+		 *
+		 * @return	the nodes of the tree
+		 */
+		TArray<UObject*> BuildTree(int32 Num) {
+			TArray<UObject*> Tree;
+			Tree.Add(CreateNode());
+			while (Tree.Num() < Num) {
+				UObject* Node = CreateNode();
+				Connect(Tree[Random.RandRange(0, Tree.Num()-1)], Node);
+				Tree.Add(Node);
+			}
+			return Tree;
+		}
+
+		void Connect(UObject* A, UObject* B) {
+			AsTestNode(A)->Connected.Add(B);
+			AsTestNode(B)->Connected.Add(A);
+			Edges.Emplace(A, B);
+			AFINNetworkCircuit::ConnectNodes(World, TScriptInterface<IFINNetworkCircuitNode>(A), TScriptInterface<IFINNetworkCircuitNode>(B));
+		}
+
+		void Disconnect(int32 EdgeIndex) {
+			const TPair<UObject*, UObject*> Edge = Edges[EdgeIndex];
+			Edges.RemoveAtSwap(EdgeIndex);
+			AsTestNode(Edge.Key)->Connected.Remove(Edge.Value);
+			AsTestNode(Edge.Value)->Connected.Remove(Edge.Key);
+			AFINNetworkCircuit::DisconnectNodes(World, TScriptInterface<IFINNetworkCircuitNode>(Edge.Key), TScriptInterface<IFINNetworkCircuitNode>(Edge.Value));
+		}
+
+		UFINNetworkCircuitTestNode* RandomComponent() {
+			while (true) {
+				if (UFINNetworkCircuitTestNode* Comp = Cast<UFINNetworkCircuitTestNode>(Nodes[Random.RandRange(0, Nodes.Num()-1)])) return Comp;
+			}
+		}
+
+		/**
+		 * Checks that all lookups of every circuit match a walk of the nodes belonging to the circuit.
+		 */
+		void Verify(FAutomationTestBase& Test, const TCHAR* Phase) {
+			TMap<AFINNetworkCircuit*, TArray<UObject*>> Circuits;
+			for (UObject* Node : Nodes) {
+				Circuits.FindOrAdd(AsTestNode(Node)->Circuit).Add(Node);
+			}
+
+			for (const TPair<AFINNetworkCircuit*, TArray<UObject*>>& Members : Circuits) {
+				AFINNetworkCircuit* Circuit = Members.Key;
+				if (!Circuit) {
+					Test.AddError(FString::Printf(TEXT("%s: %i nodes have no circuit"), Phase, Members.Value.Num()));
+					continue;
+				}
+				const TSet<UObject*> MemberSet(Members.Value);
+
+				for (UObject* Node : Nodes) {
+					const bool bMember = MemberSet.Contains(Node);
+					if (Circuit->HasNode(TScriptInterface<IFINNetworkCircuitNode>(Node)) != bMember) {
+						Test.AddError(FString::Printf(TEXT("%s: HasNode of %s differs from the node walk"), Phase, *Node->GetName()));
+					}
+					const UFINNetworkCircuitTestNode* Comp = Cast<UFINNetworkCircuitTestNode>(Node);
+					// the old lookup found any component without id when searching the invalid id, that is no longer supported
+					if (!Comp || !Comp->ID.IsValid()) continue;
+					if (Circuit->FindComponent(Comp->ID, nullptr).GetObject() != Linear::FindComponent(Members.Value, Comp->ID)) {
+						Test.AddError(FString::Printf(TEXT("%s: FindComponent of %s differs from the node walk"), Phase, *Node->GetName()));
+					}
+				}
+
+				for (const TCHAR* Query : TestQueries) {
+					if (!SetsEqual(Circuit->FindComponentsByNick(Query, nullptr), Linear::FindComponentsByNick(Members.Value, Query))) {
+						Test.AddError(FString::Printf(TEXT("%s: FindComponentsByNick of '%s' differs from the node walk"), Phase, Query));
+					}
+				}
+
+				UClass* Classes[] = {UObject::StaticClass(), UFINNetworkCircuitTestConnector::StaticClass(), UFINNetworkCircuitTestNode::StaticClass(), UFINNetworkCircuitTestNodeVariant::StaticClass()};
+				for (UClass* Class : Classes) {
+					for (bool bRedirect : {false, true}) {
+						if (!SetsEqual(Circuit->FindComponentsByClass(Class, bRedirect, nullptr), Linear::FindComponentsByClass(Members.Value, Class, bRedirect))) {
+							Test.AddError(FString::Printf(TEXT("%s: FindComponentsByClass of %s (redirect %i) differs from the node walk"), Phase, *Class->GetName(), bRedirect));
+						}
+					}
+				}
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINNetworkCircuitIndexTest, "FicsItNetworks.Network.Circuit.Index", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFINNetworkCircuitIndexTest::RunTest(const FString& Parameters) {
+	FFINCircuitTestWorld TestWorld;
+	FFINCircuitTestNetwork Network(TestWorld.World, 1337);
+
+	const TArray<UObject*> TreeA = Network.BuildTree(150);
+	const TArray<UObject*> TreeB = Network.BuildTree(100);
+	Network.Verify(*this, TEXT("Build"));
+
+	// merges the circuits of both trees
+	Network.Connect(TreeA[Network.Random.RandRange(0, TreeA.Num()-1)], TreeB[Network.Random.RandRange(0, TreeB.Num()-1)]);
+	Network.Verify(*this, TEXT("Merge"));
+
+	for (int32 i = 0; i < 50; ++i) {
+		UFINNetworkCircuitTestNode* Comp = Network.RandomComponent();
+		switch (Network.Random.RandRange(0, 2)) {
+		case 0:
+			IFINNetworkComponent::Execute_SetNick(Comp, TestNicks[Network.Random.RandRange(0, UE_ARRAY_COUNT(TestNicks)-1)]);
+			break;
+		case 1:
+			// components without id get indexed by id with the next lookup, without an update
+			if (!Comp->ID.IsValid()) Comp->ID = FGuid::NewGuid();
+			break;
+		case 2:
+			Comp->Redirect = Comp->Redirect ? nullptr : NewObject<UFINNetworkCircuitTestNodeVariant>(TestWorld.World);
+			if (Comp->Circuit) Comp->Circuit->UpdateNode(Comp);
+			break;
+		}
+	}
+	Network.Verify(*this, TEXT("Update"));
+
+	// every edge of the trees is a bridge, so every disconnect splits a circuit
+	for (int32 i = 0; i < 20; ++i) {
+		Network.Disconnect(Network.Random.RandRange(0, Network.Edges.Num()-1));
+		if (i % 5 == 4) Network.Verify(*this, TEXT("Split"));
+	}
+
+	// reconnecting merges the split circuits again
+	for (int32 i = 0; i < 10; ++i) {
+		UObject* A = Network.Nodes[Network.Random.RandRange(0, Network.Nodes.Num()-1)];
+		UObject* B = Network.Nodes[Network.Random.RandRange(0, Network.Nodes.Num()-1)];
+		if (A != B) Network.Connect(A, B);
+	}
+	Network.Verify(*this, TEXT("Reconnect"));
+
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINNetworkCircuitBenchmark, "FicsItNetworks.Network.Circuit.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFINNetworkCircuitBenchmark::RunTest(const FString& Parameters) {
+	constexpr int32 NodeCount = 10000;
+	constexpr int32 Lookups = 1000;
+
+	FFINCircuitTestWorld TestWorld;
+	FFINCircuitTestNetwork Network(TestWorld.World, 42);
+
+	// connect the whole tree first and calculate the circuit once, merging node by node would dominate the setup
+	Network.CreateNode();
+	while (Network.Nodes.Num() < NodeCount) {
+		UObject* Parent = Network.Nodes[Network.Random.RandRange(0, Network.Nodes.Num()-1)];
+		UObject* Node = Network.CreateNode();
+		AsTestNode(Parent)->Connected.Add(Node);
+		AsTestNode(Node)->Connected.Add(Parent);
+	}
+	AFINNetworkCircuit* Circuit = TestWorld.World->SpawnActor<AFINNetworkCircuit>();
+	Circuit->Recalculate(TScriptInterface<IFINNetworkCircuitNode>(Network.Nodes[0]));
+	const TArray<UObject*>& Nodes = Network.Nodes;
+
+	TArray<FGuid> IDs;
+	TArray<UObject*> Probes;
+	for (int32 i = 0; i < Lookups; ++i) {
+		IDs.Add(Network.RandomComponent()->ID);
+		Probes.Add(Nodes[Network.Random.RandRange(0, Nodes.Num()-1)]);
+	}
+
+	auto Measure = [](TFunctionRef<void()> Func) {
+		const uint64 Start = FPlatformTime::Cycles64();
+		Func();
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+	};
+	auto Report = [this](const TCHAR* Name, double IndexTime, double LinearTime) {
+		AddInfo(FString::Printf(TEXT("%s: index %.3fms, node walk %.3fms (x%.1f)"), Name, IndexTime, LinearTime, LinearTime / FMath::Max(IndexTime, UE_DOUBLE_SMALL_NUMBER)));
+	};
+
+	int32 Found = 0;
+	Report(TEXT("FindComponent"),
+		Measure([&]() { for (const FGuid& ID : IDs) Found += Circuit->FindComponent(ID, nullptr).GetObject() != nullptr; }),
+		Measure([&]() { for (const FGuid& ID : IDs) Found -= Linear::FindComponent(Nodes, ID) != nullptr; }));
+	TestEqual(TEXT("Index and node walk found the same amount of components"), Found, 0);
+
+	Report(TEXT("HasNode"),
+		Measure([&]() { for (UObject* Node : Probes) Found += Circuit->HasNode(TScriptInterface<IFINNetworkCircuitNode>(Node)); }),
+		Measure([&]() { for (UObject* Node : Probes) Found -= Nodes.Contains(Node); }));
+	TestEqual(TEXT("Index and node walk contain the same nodes"), Found, 0);
+
+	Report(TEXT("FindComponentsByNick"),
+		Measure([&]() { for (const TCHAR* Query : TestQueries) Found += Circuit->FindComponentsByNick(Query, nullptr).Num(); }),
+		Measure([&]() { for (const TCHAR* Query : TestQueries) Found -= Linear::FindComponentsByNick(Nodes, Query).Num(); }));
+	TestEqual(TEXT("Index and node walk found the same amount of nicks"), Found, 0);
+
+	UClass* Classes[] = {UFINNetworkCircuitTestNode::StaticClass(), UFINNetworkCircuitTestNodeVariant::StaticClass()};
+	Report(TEXT("FindComponentsByClass"),
+		Measure([&]() { for (UClass* Class : Classes) Found += Circuit->FindComponentsByClass(Class, true, nullptr).Num(); }),
+		Measure([&]() { for (UClass* Class : Classes) Found -= Linear::FindComponentsByClass(Nodes, Class, true).Num(); }));
+	TestEqual(TEXT("Index and node walk found the same amount of classes"), Found, 0);
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include "Network/FINNetworkMessageDedup.h"
+
+FFINNetworkMessageDedup::FFINNetworkMessageDedup(int32 InCapacity, double InWindow) : Window(InWindow) {
+	Entries.SetNum(FMath::Max(InCapacity, 1));
+	IDs.Reserve(Entries.Num());
+}
+
+void FFINNetworkMessageDedup::EvictOldest() {
+	IDs.Remove(Entries[Head].ID);
+	Head = (Head + 1) % Entries.Num();
+	--Num;
+}
+
+bool FFINNetworkMessageDedup::TryAdd(const FGuid& ID) {
+	const double Now = FPlatformTime::Seconds();
+	FScopeLock Lock(&Mutex);
+	while (Num > 0 && Now - Entries[Head].Time > Window) EvictOldest();
+
+	bool bAlreadyHandled = false;
+	IDs.Add(ID, &bAlreadyHandled);
+	if (bAlreadyHandled) return false;
+
+	if (Num >= Entries.Num()) EvictOldest();
+	FEntry& Entry = Entries[(Head + Num) % Entries.Num()];
+	Entry.ID = ID;
+	Entry.Time = Now;
+	++Num;
+	return true;
+}
+
+void FFINNetworkMessageDedup::Reset() {
+	FScopeLock Lock(&Mutex);
+	IDs.Reset();
+	Head = 0;
+	Num = 0;
+}
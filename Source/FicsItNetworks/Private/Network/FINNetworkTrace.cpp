@@ -50,6 +50,13 @@ TMap<FString, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>> FFINNetworkTrace::
 TMap<TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>, FString> FFINNetworkTrace::inverseTraceStepRegistry;
 TMap<UClass*, TPair<TMap<UClass*, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>>, TMap<UClass*, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>>>> FFINNetworkTrace::traceStepMap;
 TMap<UClass*, TPair<TMap<UClass*, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>>, TMap<UClass*, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>>>> FFINNetworkTrace::interfaceTraceStepMap;
+std::atomic<uint32> FFINNetworkTrace::ValidationEpoch = 1;
+
+namespace {
+	// trace steps already resolved for a pair of classes
+	FRWLock ResolvedTraceStepsLock;
+	TMap<TPair<UClass*, UClass*>, TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>> ResolvedTraceSteps;
+}
 
 class FFINTraceStepRegisterer {
 public:
@@ -59,6 +66,11 @@ public:
 };
 
 void traceRegisterSteps() {
+	if (FFINNetworkTrace::toRegister.Num() < 1) return;
+	{
+		FWriteScopeLock Lock(ResolvedTraceStepsLock);
+		ResolvedTraceSteps.Empty();
+	}
 	TPair<UClass*, FString> tests = TPair<UClass*, FString>{UFINNetworkComponent::StaticClass(), ""};
 	for (auto& stepSig : FFINNetworkTrace::toRegister) {
 		auto step = stepSig();
@@ -99,11 +111,10 @@ TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> findTraceStep2(TPair<TMap<UClass*
 	return nullptr;
 }
 
-TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> FFINNetworkTrace::findTraceStep(UClass* A, UClass* B) {
-	if (!A || !B) return fallbackTraceStep;
+TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> findTraceStepUncached(UClass* A, UClass* B) {
 	UClass* Ai = A;
 	while (Ai && Ai != UObject::StaticClass()) {
-		auto stepA = traceStepMap.Find(Ai);
+		auto stepA = FFINNetworkTrace::traceStepMap.Find(Ai);
 		if (stepA) {
 			TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> step = findTraceStep2(*stepA, B);
 			if (step.IsValid()) return step;
@@ -112,28 +123,47 @@ TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> FFINNetworkTrace::findTraceStep(U
 	}
 	
 	for (FImplementedInterface& interface : A->Interfaces) {
-		auto stepA = interfaceTraceStepMap.Find(interface.Class);
+		auto stepA = FFINNetworkTrace::interfaceTraceStepMap.Find(interface.Class);
 		if (stepA) {
 			TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> step = findTraceStep2(*stepA, B);
 			if (step.IsValid()) return step;
 		}
 	}
 
-	return fallbackTraceStep;
+	return FFINNetworkTrace::fallbackTraceStep;
+}
+
+TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> FFINNetworkTrace::findTraceStep(UClass* A, UClass* B) {
+	if (!A || !B) return fallbackTraceStep;
+	const TPair<UClass*, UClass*> Key(A, B);
+	{
+		FReadScopeLock Lock(ResolvedTraceStepsLock);
+		if (const TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe>* Resolved = ResolvedTraceSteps.Find(Key)) return *Resolved;
+	}
+	TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> Step = findTraceStepUncached(A, B);
+	FWriteScopeLock Lock(ResolvedTraceStepsLock);
+	ResolvedTraceSteps.Add(Key, Step);
+	return Step;
+}
+
+void FFINNetworkTrace::InvalidateValidationCache() {
+	++ValidationEpoch;
 }
 
 FFINNetworkTrace::FFINNetworkTrace(const FFINNetworkTrace& trace) {
 	traceRegisterSteps();
 	
-	Prev = MakeShareable((trace.Prev) ? new FFINNetworkTrace(*trace.Prev) : nullptr);
+	Prev = trace.Prev;
 	Step = trace.Step;
 	Obj = trace.Obj;
+	ValidEpoch = trace.ValidEpoch.load(std::memory_order_relaxed);
 }
 
 FFINNetworkTrace& FFINNetworkTrace::operator=(const FFINNetworkTrace& trace) {
-	Prev = MakeShareable((trace.Prev) ? new FFINNetworkTrace(*trace.Prev) : nullptr);
+	Prev = trace.Prev;
 	Step = trace.Step;
 	Obj = trace.Obj;
+	ValidEpoch = trace.ValidEpoch.load(std::memory_order_relaxed);
 
 	return *this;
 }
@@ -153,11 +183,18 @@ bool FFINNetworkTrace::Serialize(FStructuredArchive::FSlot Slot) {
 		FStructuredArchive::FRecord Record = Slot.EnterRecord();
 		if (!::IsValid(Obj)) Obj = nullptr;
 		Record.EnterField(SA_FIELD_NAME(TEXT("Ptr"))) << Obj;
+		ValidEpoch = 0;
 
 		TOptional<FStructuredArchive::FSlot> PrevSlot = Record.TryEnterField(SA_FIELD_NAME(TEXT("Next")), Prev.IsValid());
 		if (PrevSlot.IsSet()) {
-			if (!Prev.IsValid()) Prev = MakeShared<FFINNetworkTrace>();
-			Prev->Serialize(PrevSlot.GetValue());
+			if (Slot.GetUnderlyingArchive().IsLoading()) {
+				// previous traces are shared, so never load into the existing one
+				TSharedRef<FFINNetworkTrace, ESPMode::ThreadSafe> LoadedPrev = MakeShared<FFINNetworkTrace, ESPMode::ThreadSafe>();
+				LoadedPrev->Serialize(PrevSlot.GetValue());
+				Prev = LoadedPrev;
+			} else {
+				const_cast<FFINNetworkTrace&>(*Prev).Serialize(PrevSlot.GetValue());
+			}
 		} else {
 			Prev.Reset();
 		}
@@ -196,7 +233,7 @@ FFINNetworkTrace FFINNetworkTrace::operator/(UObject* other) const {
 
 	UObject* A = Obj;
 	if (!::IsValid(A) || !other) return FFINNetworkTrace(nullptr); // if A is not valid, the network trace will always be not invalid
-	trace.Prev = MakeShared<FFINNetworkTrace>(*this);
+	trace.Prev = MakeShared<FFINNetworkTrace, ESPMode::ThreadSafe>(*this);
 	trace.Step = findTraceStep(A->GetClass(), other->GetClass());
 	return trace;
 }
@@ -218,6 +255,7 @@ FFINNetworkTrace FFINNetworkTrace::operator()(UObject* other) const {
 
 	FFINNetworkTrace trace(*this);
 	trace.Obj = other;
+	trace.ValidEpoch = 0;
 	
 	if (trace.Prev) {
 		auto A = trace.Prev->Obj;
@@ -235,11 +273,10 @@ bool FFINNetworkTrace::operator==(const FFINNetworkTrace& other) const {
 FFINNetworkTrace FFINNetworkTrace::Reverse() const {
 	if (!::IsValid(Obj)) return FFINNetworkTrace(nullptr);
 	FFINNetworkTrace trace(Obj);
-	TSharedPtr<FFINNetworkTrace> prev;
-	if (this->Prev) prev = MakeShared<FFINNetworkTrace>(*this->Prev);
+	const FFINNetworkTrace* prev = Prev.Get();
 	while (prev) {
 		trace = trace / prev->Obj;
-		prev = prev->Prev;
+		prev = prev->Prev.Get();
 	}
 	return trace;
 }
@@ -247,13 +284,14 @@ FFINNetworkTrace FFINNetworkTrace::Reverse() const {
 bool FFINNetworkTrace::IsValid() const {
 	UObject* B = Obj;
 	if (!::IsValid(B)) return false;
+	const uint32 Epoch = ValidationEpoch.load(std::memory_order_relaxed);
+	if (ValidEpoch.load(std::memory_order_relaxed) == Epoch) return true;
 	if (Prev && Step && *Step) {
 		UObject* A = Prev->Obj;
 		if (!A || !(*Step)(A, B)) return false;
 	}
-	if (Prev) {
-		return Prev->IsValid();
-	}
+	if (Prev && !Prev->IsValid()) return false;
+	ValidEpoch.store(Epoch, std::memory_order_relaxed);
 	return true;
 }
 
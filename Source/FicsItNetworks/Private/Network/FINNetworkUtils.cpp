@@ -6,13 +6,18 @@
 UObject* UFINNetworkUtils::FindNetworkComponentFromObject(UObject* Obj) {
 	if (!Obj) return nullptr;
 	if (Obj->Implements<UFINNetworkComponent>()) return Obj;
-	if (Obj->IsA<AActor>()) {
-		TArray<UActorComponent*> Connectors = Cast<AActor>(Obj)->GetComponentsByClass(UFINAdvancedNetworkConnectionComponent::StaticClass());
-		for (UActorComponent* Connector : Connectors) {
-			if (Connector->Implements<UFINNetworkComponent>()) return Connector;
+	if (AActor* Actor = Cast<AActor>(Obj)) {
+		// single pass over the components, connectors take precedence over adapters
+		UFINNetworkAdapterReference* Adapter = nullptr;
+		for (UActorComponent* Component : Actor->GetComponents()) {
+			if (!Component) continue;
+			if (Component->IsA<UFINAdvancedNetworkConnectionComponent>()) {
+				if (Component->Implements<UFINNetworkComponent>()) return Component;
+			} else if (!Adapter) {
+				Adapter = Cast<UFINNetworkAdapterReference>(Component);
+			}
 		}
-		TArray<UActorComponent*> Adapters = Cast<AActor>(Obj)->GetComponentsByClass(UFINNetworkAdapterReference::StaticClass());
-		if (Adapters.Num() > 0) return Cast<UFINNetworkAdapterReference>(Adapters[0])->Ref->Connector;
+		if (Adapter) return Adapter->Ref->Connector;
 	}
 	return nullptr;
 }
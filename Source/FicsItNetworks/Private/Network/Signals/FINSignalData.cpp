@@ -4,6 +4,13 @@
 bool FFINSignalData::Serialize(FStructuredArchive::FSlot Slot) {
 	FStructuredArchive::FRecord Record = Slot.EnterRecord();
 	Record.EnterField(SA_FIELD_NAME(TEXT("Signal"))) << Signal;
-	Record.EnterField(SA_FIELD_NAME(TEXT("Data"))) << Data; 
+	if (Record.GetUnderlyingArchive().IsLoading()) {
+		TSharedRef<FINArray, ESPMode::ThreadSafe> LoadedData = MakeShared<FINArray, ESPMode::ThreadSafe>();
+		Record.EnterField(SA_FIELD_NAME(TEXT("Data"))) << *LoadedData;
+		Data = LoadedData;
+	} else {
+		// saving doesn't modify the shared parameters
+		Record.EnterField(SA_FIELD_NAME(TEXT("Data"))) << const_cast<FINArray&>(GetData());
+	}
 	return true;
 }
@@ -9,6 +9,16 @@ void FFINSignalListeners::AddStructReferencedObjects(FReferenceCollector& Refere
 	for (const FFINNetworkTrace& Trace : Listeners) {
 		Trace.AddStructReferencedObjects(ReferenceCollector);
 	}
+	for (const FFINNetworkTrace& Trace : ReversedListeners) {
+		Trace.AddStructReferencedObjects(ReferenceCollector);
+	}
+}
+
+void FFINSignalListeners::UpdateReversedListeners() {
+	ReversedListeners.Empty(Listeners.Num());
+	for (const FFINNetworkTrace& Listener : Listeners) {
+		ReversedListeners.Add(Listener.Reverse());
+	}
 }
 
 bool AFINSignalSubsystem::ShouldSave_Implementation() const {
@@ -20,7 +30,9 @@ void AFINSignalSubsystem::PreSaveGame_Implementation(int32 saveVersion, int32 ga
 }
 
 void AFINSignalSubsystem::PostLoadGame_Implementation(int32 saveVersion, int32 gameVersion) {
-	
+	for (TPair<UObject*, FFINSignalListeners>& Sender : Listeners) {
+		Sender.Value.UpdateReversedListeners();
+	}
 }
 
 void AFINSignalSubsystem::GatherDependencies_Implementation(TArray<UObject*>& out_dependentObjects) {
@@ -45,11 +57,14 @@ void AFINSignalSubsystem::Cleanup() {
 		if (!IsValid(Sender)) {
 			Listeners.Remove(Sender);
 		} else {
-			TArray<FFINNetworkTrace>& Listen = Listeners[Sender].Listeners;
+			FFINSignalListeners& SenderListeners = Listeners[Sender];
+			TArray<FFINNetworkTrace>& Listen = SenderListeners.Listeners;
 			for (int i = 0; i < Listen.Num(); ++i) {
 				const FFINNetworkTrace& Listener = Listen[i];
 				if (!IsValid(Listener.GetUnderlyingPtr())) {
-					Listen.RemoveAt(i--);
+					Listen.RemoveAt(i);
+					if (SenderListeners.ReversedListeners.IsValidIndex(i)) SenderListeners.ReversedListeners.RemoveAt(i);
+					--i;
 				}
 			}
 			if (Listen.Num() < 1) {
@@ -69,21 +84,28 @@ AFINSignalSubsystem* AFINSignalSubsystem::GetSignalSubsystem(UObject* WorldConte
 void AFINSignalSubsystem::BroadcastSignal(UObject* Sender, const FFINSignalData& Signal) {
 	FFINSignalListeners* ListenerList = Listeners.Find(Sender);
 	if (!ListenerList) return;
-	for (const FFINNetworkTrace& ReceiverTrace : ListenerList->Listeners) {
-		if (&ReceiverTrace == nullptr) {
-			UE_LOG(LogFicsItNetworks, Warning, TEXT("SignalSubsystem: Invalid receiver trave. Sender: %s, ListenerList: %p, Listeners.Num(): %i"), *Sender->GetName(), ListenerList, ListenerList->Listeners.Num());
-			continue;
-		}
+	// the reversed traces get created when listening, only reverse here if they are out of sync for some reason
+	const bool bReversed = ListenerList->ReversedListeners.Num() == ListenerList->Listeners.Num();
+	for (int32 i = 0; i < ListenerList->Listeners.Num(); ++i) {
+		const FFINNetworkTrace& ReceiverTrace = ListenerList->Listeners[i];
 		IFINSignalListener* Receiver = Cast<IFINSignalListener>(ReceiverTrace.Get());
 		if (Receiver) {
-			Receiver->HandleSignal(Signal, ReceiverTrace.Reverse());
+			if (bReversed) {
+				Receiver->HandleSignal(Signal, ListenerList->ReversedListeners[i]);
+			} else {
+				Receiver->HandleSignal(Signal, ReceiverTrace.Reverse());
+			}
 		}
 	}
 }
 
 void AFINSignalSubsystem::Listen(UObject* Sender, const FFINNetworkTrace& Receiver) {
-	TArray<FFINNetworkTrace>& ListenerList = Listeners.FindOrAdd(Sender).Listeners;
-	ListenerList.AddUnique(Receiver);
+	FFINSignalListeners& ListenerList = Listeners.FindOrAdd(Sender);
+	if (!ListenerList.Listeners.Contains(Receiver)) {
+		if (ListenerList.ReversedListeners.Num() != ListenerList.Listeners.Num()) ListenerList.UpdateReversedListeners();
+		ListenerList.Listeners.Add(Receiver);
+		ListenerList.ReversedListeners.Add(Receiver.Reverse());
+	}
 	AFINHookSubsystem::GetHookSubsystem(Sender)->AttachHooks(Sender);
 }
 
@@ -93,6 +115,7 @@ void AFINSignalSubsystem::Ignore(UObject* Sender, UObject* Receiver) {
 	for (int i = 0; i < ListenerList->Listeners.Num(); ++i) {
 		if (ListenerList->Listeners[i].GetUnderlyingPtr() == Receiver) {
 			ListenerList->Listeners.RemoveAt(i);
+			if (ListenerList->ReversedListeners.IsValidIndex(i)) ListenerList->ReversedListeners.RemoveAt(i);
 			--i;
 		}
 	}
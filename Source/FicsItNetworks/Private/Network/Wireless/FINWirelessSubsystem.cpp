@@ -30,12 +30,9 @@ TArray<AFINWirelessAccessPoint*> AFINWirelessSubsystem::GetAccessPoints() {
 }
 
 /**
- * Update each access point, storing the reachable access points from the current one.
+ * Rebuilds the tower index and updates each access point, storing the reachable access points from the current one.
  * We use this mechanism to avoid recomputing the network wireless connections each tick.
- *
- * TODO Right now the algorithm is simple and reuses the GetAvailableWirelessConnections method from the AccessPoint.
- * We could refactor it with some optimization like computing the topology of the network and only update the connections,
- * but it's not a big deal given the small amount of access points needed in the map.
+ * Single towers and access points getting built or removed only re-link their neighbourhood.
  */
 void AFINWirelessSubsystem::RecalculateWirelessConnections() {
 	// Only the host keeps updated the wireless connections. Guest clients use the replicated data
@@ -46,20 +43,168 @@ void AFINWirelessSubsystem::RecalculateWirelessConnections() {
 
 	// Update cache
 	CacheTowersAndAccessPoints();
-	
+
+	TowerGrid.Empty();
+	TowerCells.Empty();
+	TowerAccessPoints.Empty();
+	for (AActor* Actor : CachedRadarTowers) {
+		IndexRadarTower(Cast<AFGBuildableRadarTower>(Actor));
+	}
 	const TArray<AFINWirelessAccessPoint*> AccessPoints = GetAccessPoints();
 	for (const auto AccessPoint : AccessPoints) {
-		AccessPoint->mWirelessConnections =  {};
+		if (IsValid(AccessPoint->AttachedTower)) {
+			TowerAccessPoints.Add(AccessPoint->AttachedTower, AccessPoint);
+		}
+	}
+	bIndexBuilt = true;
+	
+	for (const auto AccessPoint : AccessPoints) {
+		UpdateAccessPointConnections(AccessPoint);
+	}
+}
+
+void AFINWirelessSubsystem::AddRadarTower(AFGBuildableRadarTower* Tower) {
+	if (!HasAuthority() || !IsValid(Tower)) return;
+	if (!bIndexBuilt) {
+		RecalculateWirelessConnections();
+		return;
+	}
+	
+	CachedRadarTowers.AddUnique(Tower);
+	IndexRadarTower(Tower);
+	UpdateConnectionsAround(Tower->GetActorLocation());
+}
+
+void AFINWirelessSubsystem::RemoveRadarTower(AFGBuildableRadarTower* Tower) {
+	if (!HasAuthority() || !Tower) return;
+	if (!bIndexBuilt) {
+		RecalculateWirelessConnections();
+		return;
+	}
+
+	CachedRadarTowers.Remove(Tower);
+	UnindexRadarTower(Tower);
+	TWeakObjectPtr<AFINWirelessAccessPoint> AccessPoint;
+	if (TowerAccessPoints.RemoveAndCopyValue(Tower, AccessPoint) && AccessPoint.IsValid()) {
+		AccessPoint->mWirelessConnections.Empty();
+	}
+	UpdateConnectionsAround(Tower->GetActorLocation());
+}
+
+void AFINWirelessSubsystem::AddAccessPoint(AFINWirelessAccessPoint* AccessPoint) {
+	if (!HasAuthority() || !IsValid(AccessPoint)) return;
+	if (!bIndexBuilt) {
+		RecalculateWirelessConnections();
+		return;
+	}
+
+	CachedAccessPoints.AddUnique(AccessPoint);
+	AFGBuildableRadarTower* Tower = AccessPoint->AttachedTower;
+	if (!IsValid(Tower)) return;
+	if (!TowerCells.Contains(Tower)) {
+		CachedRadarTowers.AddUnique(Tower);
+		IndexRadarTower(Tower);
+	}
+	TowerAccessPoints.Add(Tower, AccessPoint);
+	// also links the new access point itself
+	UpdateConnectionsAround(Tower->GetActorLocation());
+}
+
+void AFINWirelessSubsystem::RemoveAccessPoint(AFINWirelessAccessPoint* AccessPoint) {
+	if (!HasAuthority() || !AccessPoint) return;
+	if (!bIndexBuilt) {
+		RecalculateWirelessConnections();
+		return;
+	}
 
-		const TArray<UFINWirelessAccessPointConnection*> Connections = GetAvailableConnections(AccessPoint);
-		for (const auto Connection : Connections) {
-			if (Connection->CanCommunicate()) {
-				AccessPoint->mWirelessConnections.Emplace(Connection);
+	CachedAccessPoints.Remove(AccessPoint);
+	AccessPoint->mWirelessConnections.Empty();
+	AFGBuildableRadarTower* Tower = AccessPoint->AttachedTower;
+	if (!Tower) return;
+	const TWeakObjectPtr<AFINWirelessAccessPoint>* Attached = TowerAccessPoints.Find(Tower);
+	if (Attached && Attached->Get() == AccessPoint) {
+		TowerAccessPoints.Remove(Tower);
+	}
+	UpdateConnectionsAround(Tower->GetActorLocation());
+}
+
+FIntPoint AFINWirelessSubsystem::GetGridCell(const FVector& Location) {
+	return FIntPoint(FMath::FloorToInt(Location.X / GridCellSize), FMath::FloorToInt(Location.Y / GridCellSize));
+}
+
+void AFINWirelessSubsystem::ForEachTowerInReach(const FVector& Location, float Reach, TFunctionRef<void(AFGBuildableRadarTower*)> Func) {
+	// the XY distance is never larger than the actual distance, so the cells cover every tower in reach
+	const FIntPoint Min = GetGridCell(Location - FVector(Reach, Reach, 0));
+	const FIntPoint Max = GetGridCell(Location + FVector(Reach, Reach, 0));
+	for (int32 X = Min.X; X <= Max.X; ++X) {
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+			const TArray<TWeakObjectPtr<AFGBuildableRadarTower>>* Cell = TowerGrid.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+			for (const TWeakObjectPtr<AFGBuildableRadarTower>& Tower : *Cell) {
+				if (Tower.IsValid() && !Tower->IsActorBeingDestroyed()) Func(Tower.Get());
 			}
 		}
 	}
 }
 
+void AFINWirelessSubsystem::IndexRadarTower(AFGBuildableRadarTower* Tower) {
+	if (!IsValid(Tower) || TowerCells.Contains(Tower)) return;
+	const FIntPoint Cell = GetGridCell(Tower->GetActorLocation());
+	TowerGrid.FindOrAdd(Cell).Add(Tower);
+	TowerCells.Add(Tower, Cell);
+}
+
+void AFINWirelessSubsystem::UnindexRadarTower(AFGBuildableRadarTower* Tower) {
+	FIntPoint Cell;
+	if (!TowerCells.RemoveAndCopyValue(Tower, Cell)) return;
+	TArray<TWeakObjectPtr<AFGBuildableRadarTower>>* Towers = TowerGrid.Find(Cell);
+	if (!Towers) return;
+	Towers->RemoveAllSwap([Tower](const TWeakObjectPtr<AFGBuildableRadarTower>& Other) {
+		return !Other.IsValid() || Other.Get() == Tower;
+	});
+	if (Towers->Num() < 1) TowerGrid.Remove(Cell);
+}
+
+void AFINWirelessSubsystem::UpdateConnectionsAround(const FVector& Location) {
+	// a tower at the location may reach every tower within twice the maximum range
+	ForEachTowerInReach(Location, 2 * AFINWirelessAccessPoint::MaxWirelessRange, [this](AFGBuildableRadarTower* Tower) {
+		const TWeakObjectPtr<AFINWirelessAccessPoint>* AccessPoint = TowerAccessPoints.Find(Tower);
+		if (AccessPoint && AccessPoint->IsValid()) UpdateAccessPointConnections(AccessPoint->Get());
+	});
+}
+
+void AFINWirelessSubsystem::UpdateAccessPointConnections(AFINWirelessAccessPoint* AccessPoint) {
+	const TArray<UFINWirelessAccessPointConnection*> OldConnections = MoveTemp(AccessPoint->mWirelessConnections);
+	AccessPoint->mWirelessConnections.Reset();
+	
+	AFGBuildableRadarTower* AttachedTower = AccessPoint->AttachedTower;
+	if (!IsValid(AttachedTower) || !TowerCells.Contains(AttachedTower)) return;
+	const float AttachedRange = AFINWirelessAccessPoint::GetWirelessRange(AttachedTower);
+
+	ForEachTowerInReach(AttachedTower->GetActorLocation(), AttachedRange + AFINWirelessAccessPoint::MaxWirelessRange, [&](AFGBuildableRadarTower* TargetTower) {
+		if (TargetTower == AttachedTower) return;
+		const TWeakObjectPtr<AFINWirelessAccessPoint>* TargetAccessPoint = TowerAccessPoints.Find(TargetTower);
+		if (!TargetAccessPoint || !TargetAccessPoint->IsValid() || TargetAccessPoint->Get() == AccessPoint) return;
+
+		// repeated connections are not needed for routing, since repetition is handled by the other access points
+		const float Distance = TargetTower->GetDistanceTo(AttachedTower);
+		if (AttachedRange + AFINWirelessAccessPoint::GetWirelessRange(TargetTower) <= Distance) return;
+
+		UFINWirelessAccessPointConnection* const* OldConnection = OldConnections.FindByPredicate([TargetTower](const UFINWirelessAccessPointConnection* Connection) {
+			return Connection && Connection->RadarTower.Get() == TargetTower;
+		});
+		UFINWirelessAccessPointConnection* Connection = OldConnection ? *OldConnection : NewObject<UFINWirelessAccessPointConnection>(this);
+		Connection->RadarTower = TargetTower;
+		Connection->AccessPoint = TargetAccessPoint->Get();
+		Connection->Data.Distance = Distance;
+		Connection->Data.IsInRange = true;
+		Connection->Data.IsConnected = true;
+		Connection->Data.IsRepeated = false;
+		Connection->Data.IsSelf = false;
+		AccessPoint->mWirelessConnections.Add(Connection);
+	});
+}
+
 /**
  * Finds all the connections between the selected access point and the others.
  * All data (towers & waps) are cached in the subsystem.
@@ -72,13 +217,7 @@ TArray<UFINWirelessAccessPointConnection*> AFINWirelessSubsystem::GetAvailableCo
 
 	const float AttachedRange = AFINWirelessAccessPoint::GetWirelessRange(AttachedTower);
 	
-	// We register the accesspoint-radartower connection
-	TMap<AFGBuildableRadarTower*, AFINWirelessAccessPoint*> AccessPointsAttachments;
-	for (AActor* Actor : CachedAccessPoints) {
-		if (const auto AccessPoint = Cast<AFINWirelessAccessPoint>(Actor); IsValid(AccessPoint) && IsValid(AccessPoint->AttachedTower)) {
-			AccessPointsAttachments.Add(AccessPoint->AttachedTower, AccessPoint);
-		}
-	}
+	if (!bIndexBuilt) RecalculateWirelessConnections();
 
 	// Sort all the towers putting the nearest first. This way we can check all the previous towers
 	// For a connection to the next tower.
@@ -96,8 +235,9 @@ TArray<UFINWirelessAccessPointConnection*> AFINWirelessSubsystem::GetAvailableCo
 		const float TargetRange = AFINWirelessAccessPoint::GetWirelessRange(TargetTower);
 		
 		const float Distance = TargetTower->GetDistanceTo(AttachedTower);
-		AFINWirelessAccessPoint** AccessPoint = AccessPointsAttachments.Find(TargetTower);
-		const bool IsConnected = AccessPoint != nullptr;
+		const TWeakObjectPtr<AFINWirelessAccessPoint>* AttachedAccessPoint = TowerAccessPoints.Find(TargetTower);
+		AFINWirelessAccessPoint* AccessPoint = AttachedAccessPoint ? AttachedAccessPoint->Get() : nullptr;
+		const bool IsConnected = IsValid(AccessPoint);
 
 		// If RadarTower is not inside the AccessPoint range, it could still be connected through
 		// repeaters antennas (WAP1 -> WAP2 -> WAP3).
@@ -121,12 +261,12 @@ TArray<UFINWirelessAccessPointConnection*> AFINWirelessSubsystem::GetAvailableCo
 
 		const auto FoundConnection = NewObject<UFINWirelessAccessPointConnection>();
 		FoundConnection->RadarTower = TargetTower;
-		FoundConnection->AccessPoint = IsConnected ?  *AccessPoint : nullptr;
+		FoundConnection->AccessPoint = IsConnected ? AccessPoint : nullptr;
 		FoundConnection->Data.Distance = Distance;
 		FoundConnection->Data.IsInRange = IsInRange;
 		FoundConnection->Data.IsConnected = IsConnected;
 		FoundConnection->Data.IsRepeated = IsRepeated;
-		FoundConnection->Data.IsSelf = IsConnected && CurrentAccessPoint == *AccessPoint;
+		FoundConnection->Data.IsSelf = IsConnected && CurrentAccessPoint == AccessPoint;
 
 		// Cached data for replication
 		FoundConnection->Data.RepresentationLocation = TargetTower->GetActorLocation();
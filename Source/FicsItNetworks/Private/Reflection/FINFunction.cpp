@@ -6,3 +6,18 @@ TArray<FFINAnyNetworkValue> UFINFunction::Execute(const FFINExecutionContext& Ct
 	if (NativeFunction) return NativeFunction(Ctx, Params);
 	return TArray<FFINAnyNetworkValue>();
 }
+
+void UFINFunction::BuildCallLayout() const {
+	FScopeLock Lock(&CallLayoutMutex);
+	if (bCallLayoutBuilt.load(std::memory_order_relaxed)) return;
+	for (UFINProperty* Param : GetParameters()) {
+		const EFINRepPropertyFlags Flags = Param->GetPropertyFlags();
+		if (!(Flags & FIN_Prop_Param)) continue;
+		if (Flags & (FIN_Prop_OutParam | FIN_Prop_RetVal)) {
+			CallLayout.OutputParameters.Add(Param);
+		} else {
+			CallLayout.InputParameters.Add(Param);
+		}
+	}
+	bCallLayoutBuilt.store(true, std::memory_order_release);
+}
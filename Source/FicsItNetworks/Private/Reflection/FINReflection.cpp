@@ -96,6 +96,7 @@ UFINClass* FFINReflection::FindClass(UClass* Clazz, bool bRecursive, bool bTryTo
 				for (const UFINReflectionSource* Source : Sources) {
 					Source->FillData(this, Class, Clazz);
 				}
+				Class->InvalidateCache();
 				ClassNames.Add(Class->GetInternalName(), Class);
 				return Class;
 			}
@@ -146,6 +147,7 @@ UFINStruct* FFINReflection::FindStruct(UScriptStruct* Struct, bool bRecursive, b
 				for (const UFINReflectionSource* Source : Sources) {
 					Source->FillData(this, FINStruct, Struct);
 				}
+				FINStruct->InvalidateCache();
 				StructNames.Add(FINStruct->GetInternalName(), FINStruct);
 				return FINStruct;
 			}
@@ -1,4 +1,3 @@
 ﻿#include "Reflection/FINStaticReflectionSourceHooks.h"
 
-FCriticalSection UFINFactoryConnectorHook::MutexFactoryGrab;
-TMap<TWeakObjectPtr<UFGFactoryConnectionComponent>, int8> UFINFactoryConnectorHook::FactoryGrabsRunning;
+thread_local TArray<UFGFactoryConnectionComponent*, TInlineAllocator<4>> UFINFactoryConnectorHook::FactoryGrabsRunning;
@@ -1,17 +1,73 @@
 ﻿#include "Reflection/FINStruct.h"
 
+#include "Algo/BinarySearch.h"
 #include "tracy/Tracy.hpp"
 
-UFINProperty* UFINStruct::FindFINProperty(const FString& Name, EFINRepPropertyFlags FilterFlags) {
-	ZoneScoped;
-	FScopeLock nameCacheLock(&NameCacheMutex);
-	if (Name2Property.IsEmpty()) {
-		for (UFINProperty* Property : GetProperties()) {
-			Name2Property.FindOrAdd(Property->GetInternalName()).Add(Property);
+namespace {
+	template<typename T>
+	void BuildNameTable(const TArray<T*>& Members, TArray<FFINStructMemberTable::FName2Index>& OutNames) {
+		OutNames.Reserve(Members.Num());
+		for (int32 i = 0; i < Members.Num(); ++i) {
+			OutNames.Add({Members[i]->GetInternalName(), i});
 		}
+		OutNames.Sort([](const FFINStructMemberTable::FName2Index& A, const FFINStructMemberTable::FName2Index& B) {
+			const int32 Compare = A.Name.Compare(B.Name, ESearchCase::IgnoreCase);
+			if (Compare != 0) return Compare < 0;
+			return A.Index < B.Index;
+		});
+	}
+
+	/**
+	 * Returns the index of the first entry in the name table with the given name, or the amount of entries if there is none
+	 */
+	int32 FindFirstName(const TArray<FFINStructMemberTable::FName2Index>& Names, const FString& Name) {
+		return Algo::LowerBound(Names, Name, [](const FFINStructMemberTable::FName2Index& Entry, const FString& Name) {
+			return Entry.Name.Compare(Name, ESearchCase::IgnoreCase) < 0;
+		});
+	}
+}
+
+void UFINStruct::BeginDestroy() {
+	Super::BeginDestroy();
+	
+	FScopeLock Lock(&MemberTableMutex);
+	delete MemberTable.exchange(nullptr);
+	RetiredMemberTables.Empty();
+}
+
+const FFINStructMemberTable* UFINStruct::BuildMemberTable() const {
+	ZoneScoped;
+	FFINStructMemberTable* Table = new FFINStructMemberTable();
+	Table->Epoch = MemberTableEpoch.load(std::memory_order_acquire);
+	Table->Properties = Properties;
+	Table->Functions = Functions;
+	if (UFINStruct* ParentStruct = GetParent()) {
+		const FFINStructMemberTable& ParentTable = ParentStruct->GetMemberTable();
+		Table->Properties.Append(ParentTable.Properties);
+		Table->Functions.Append(ParentTable.Functions);
+	}
+	BuildNameTable(Table->Properties, Table->PropertyNames);
+	BuildNameTable(Table->Functions, Table->FunctionNames);
+
+	FScopeLock Lock(&MemberTableMutex);
+	const FFINStructMemberTable* OldTable = MemberTable.load(std::memory_order_acquire);
+	if (OldTable && OldTable->Epoch == Table->Epoch) {
+		// another thread was faster
+		delete Table;
+		return OldTable;
 	}
-	TArray<UFINProperty*>* Props = Name2Property.Find(Name);
-	if (Props) for (UFINProperty* Property : *Props) {
+	if (OldTable) RetiredMemberTables.Emplace(OldTable);
+	MemberTable.store(Table, std::memory_order_release);
+	return Table;
+}
+
+UFINProperty* UFINStruct::FindFINProperty(const FString& Name, EFINRepPropertyFlags FilterFlags) {
+	ZoneScoped;
+	const FFINStructMemberTable& Table = GetMemberTable();
+	for (int32 i = FindFirstName(Table.PropertyNames, Name); i < Table.PropertyNames.Num(); ++i) {
+		const FFINStructMemberTable::FName2Index& Entry = Table.PropertyNames[i];
+		if (!Entry.Name.Equals(Name, ESearchCase::IgnoreCase)) break;
+		UFINProperty* Property = Table.Properties[Entry.Index];
 		if (Property->GetPropertyFlags() & FilterFlags) return Property;
 	}
 	return nullptr;
@@ -19,14 +75,11 @@ UFINProperty* UFINStruct::FindFINProperty(const FString& Name, EFINRepPropertyFl
 
 UFINFunction* UFINStruct::FindFINFunction(const FString& Name, EFINFunctionFlags FilterFlags) {
 	ZoneScoped;
-	FScopeLock nameCacheLock(&NameCacheMutex);
-	if (Name2Function.IsEmpty()) {
-		for (UFINFunction* Function : GetFunctions()) {
-			Name2Function.FindOrAdd(Function->GetInternalName()).Add(Function);
-		}
-	}
-	TArray<UFINFunction*>* Funcs = Name2Function.Find(Name);
-	if (Funcs) for (UFINFunction* Function : *Funcs) {
+	const FFINStructMemberTable& Table = GetMemberTable();
+	for (int32 i = FindFirstName(Table.FunctionNames, Name); i < Table.FunctionNames.Num(); ++i) {
+		const FFINStructMemberTable::FName2Index& Entry = Table.FunctionNames[i];
+		if (!Entry.Name.Equals(Name, ESearchCase::IgnoreCase)) break;
+		UFINFunction* Function = Table.Functions[Entry.Index];
 		if (Function->GetFunctionFlags() & FilterFlags) return Function;
 	}
 	return nullptr;
@@ -11,7 +11,8 @@ TArray<FFINAnyNetworkValue> UFINUFunction::Execute(const FFINExecutionContext& C
 		UObject* Obj = Ctx.GetObject();
 		if (!Obj) throw FFINReflectionException(const_cast<UFINUFunction*>(this), "No valid object used for function execution.");
 		
-		TArray<FFINAnyNetworkValue> Output;
+		const FFINFunctionCallLayout& Layout = GetCallLayout();
+		
 		// allocate & initialize parameter struct
 		uint8* ParamStruct = (uint8*)FMemory_Alloca(RefFunction->GetStructureSize());
 		if (ParamStruct) RefFunction->InitializeStruct(ParamStruct);
@@ -20,19 +21,14 @@ TArray<FFINAnyNetworkValue> UFINUFunction::Execute(const FFINExecutionContext& C
 		};
 		
 		// copy parameters to parameter struct
-		int i = 0;
-		TArray<UFINProperty*> Properties = GetParameters();
-		for (int j = 0; j < Properties.Num(); ++j) {
-			UFINProperty* Param = Properties[j];
-			if ((Param->GetPropertyFlags() & FIN_Prop_Param) && !(Param->GetPropertyFlags() & FIN_Prop_OutParam)) {
-				if (Params.Num() <= i) throw FFINReflectionException(const_cast<UFINUFunction*>(this), FString::Printf(TEXT("Required parameter '%s' is not provided."), *Param->GetInternalName())); 
-				Param->SetValue(ParamStruct, Params[i++]);
-			}
+		const int32 InputNum = Layout.InputParameters.Num();
+		if (Params.Num() < InputNum) throw FFINReflectionException(const_cast<UFINUFunction*>(this), FString::Printf(TEXT("Required parameter '%s' is not provided."), *Layout.InputParameters[Params.Num()]->GetInternalName()));
+		for (int32 i = 0; i < InputNum; ++i) {
+			Layout.InputParameters[i]->SetValue(ParamStruct, Params[i]);
 		}
-		if (GetFunctionFlags() & FIN_Func_VarArgs && Params.Num() > i) {
-			TArray<FFINAnyNetworkValue> VarArgs = TArray(&Params[i], Params.Num()-i);
-			VarArgsProperty->SetValue(ParamStruct, VarArgs);
-			i = Params.Num();
+		if (GetFunctionFlags() & FIN_Func_VarArgs && Params.Num() > InputNum) {
+			TArray<FFINAnyNetworkValue> VarArgs = TArray(&Params[InputNum], Params.Num()-InputNum);
+			VarArgsProperty->SetValue(ParamStruct, MoveTemp(VarArgs));
 		}
 
 		{
@@ -41,10 +37,10 @@ TArray<FFINAnyNetworkValue> UFINUFunction::Execute(const FFINExecutionContext& C
 		}
 
 		// copy output parameters from paramter struct
-		for (UFINProperty* Param : Parameters) {
-			if ((Param->GetPropertyFlags() & FIN_Prop_Param) && (Param->GetPropertyFlags() & FIN_Prop_OutParam)) {
-				Output.Add(Param->GetValue(ParamStruct));
-			}
+		TArray<FFINAnyNetworkValue> Output;
+		Output.Reserve(Layout.OutputParameters.Num());
+		for (UFINProperty* Param : Layout.OutputParameters) {
+			Output.Add(Param->GetValue(ParamStruct));
 		}
 		
 		return Output;
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Network/FINAdvancedNetworkConnectionComponent.h"
+#include "Network/FINNetworkMessageDedup.h"
 #include "Buildables/FGBuildable.h"
 #include "FINNetworkRouter.generated.h"
 
@@ -16,6 +17,19 @@ enum EFINNetworkRouterLampFlags {
 };
 ENUM_CLASS_FLAGS(EFINNetworkRouterLampFlags);
 
+/**
+ * A network message waiting to get forwarded by a network router
+ */
+struct FFINNetworkRouterMessage {
+	// true if the message gets forwarded into the circuit of the second connector
+	bool bToConnector2 = false;
+	FGuid ID;
+	FGuid Sender;
+	FGuid Receiver;
+	int Port = 0;
+	TArray<FFINAnyNetworkValue> Data;
+};
+
 UCLASS()
 class AFINNetworkRouter : public AFGBuildable {
 	GENERATED_BODY()
@@ -39,9 +53,7 @@ public:
 	UPROPERTY(SaveGame)
 	TArray<FString> AddrList;
 
-	UPROPERTY()
-	TArray<FGuid> HandledMessages;
-	FCriticalSection HandleMessageMutex;
+	FFINNetworkMessageDedup HandledMessages;
 
 	EFINNetworkRouterLampFlags LampFlags;
 
@@ -182,7 +194,35 @@ public:
     void OnMessageHandled(bool bCon1or2, bool bSendOrReceive);
 	
 private:
-	bool HandleMessage(AFINNetworkCircuit* SendingCircuit, const FGuid& ID, const FGuid& Sender, const FGuid& Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data);
+	// The port and address lists compiled to sets, guarded by the filter lock
+	FRWLock FilterLock;
+	TSet<int> PortFilter;
+	TSet<FGuid> AddrFilter;
+
+	/**
+	 * Compiles the port and address lists to the filter sets, has to get called on every change of the lists
+	 */
+	void UpdateFilters();
+
+	bool IsPortAllowed(int Port);
+
+	// Messages received since the last tick, they get forwarded all at once with the next tick
+	FCriticalSection PendingMessagesMutex;
+	TArray<FFINNetworkRouterMessage> PendingMessages;
+
+	/**
+	 * Filters the given message and queues it to get forwarded with the next tick.
+	 *
+	 * @return	true if the message will get forwarded
+	 */
+	bool QueueMessage(bool bToConnector2, const FGuid& ID, const FGuid& Sender, const FGuid& Reciever, int Port, const TArray<FFINAnyNetworkValue>& Data);
+
+	/**
+	 * Forwards all queued messages into the circuits of the connectors.
+	 */
+	void ForwardPendingMessages();
+	
+	bool HandleMessage(AFINNetworkCircuit* SendingCircuit, const FFINNetworkRouterMessage& Message);
 
 	UFUNCTION(NetMulticast, Unreliable)
     void NetMulti_OnMessageHandled(EFINNetworkRouterLampFlags Flags);
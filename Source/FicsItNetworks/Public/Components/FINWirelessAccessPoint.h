@@ -2,6 +2,7 @@
 
 #include "FicsItNetworksModule.h"
 #include "Network/FINAdvancedNetworkConnectionComponent.h"
+#include "Network/FINNetworkMessageDedup.h"
 #include "Network/Wireless/FINWirelessAccessPointConnection.h"
 #include "Network/Wireless/FINWirelessSubsystem.h"
 #include "Buildables/FGBuildable.h"
@@ -51,6 +52,9 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	// End Networking
 
+	// The wireless range of the highest radar tower
+	static constexpr float MaxWirelessRange = 212000.0f;
+
 	static float GetWirelessRange(AFGBuildableRadarTower* TargetTower);
 
 	UFUNCTION(BlueprintCallable, Category="Network|Wireless")
@@ -90,9 +94,7 @@ public:
 		OnWirelessConnectionsDataUpdated.Broadcast();
 	}
 
-	UPROPERTY()
-	TArray<FGuid> HandledMessages;
-	FCriticalSection HandleMessageMutex;
+	FFINNetworkMessageDedup HandledMessages;
 
 private:
 	/**
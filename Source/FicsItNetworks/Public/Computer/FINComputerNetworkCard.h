@@ -5,6 +5,7 @@
 #include "Network/FINNetworkCircuitNode.h"
 #include "Network/FINNetworkComponent.h"
 #include "Network/FINNetworkMessageInterface.h"
+#include "Network/FINNetworkMessageDedup.h"
 #include "Network/Signals/FINSignalData.h"
 #include "FINComputerNetworkCard.generated.h"
 
@@ -54,17 +55,14 @@ public:
 	AFINNetworkCircuit* Circuit = nullptr;
 
 	/**
-	 * Set of ID of already handled network messages since last tick.
+	 * IDs of recently handled network messages.
 	 */
-	UPROPERTY()
-	TSet<FGuid> HandledMessages;
-	FCriticalSection HandledMessagesMutex;
+	FFINNetworkMessageDedup HandledMessages;
 
 	AFINComputerNetworkCard();
 	
 	// Begin AActor
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
 	// End AActor
 
 	// Begin IFINNetworkCircuitNode
@@ -5,6 +5,9 @@
 #include "Listener.h"
 #include "WindowsFileWatcher.h"
 
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace CodersFileSystem {
@@ -107,12 +110,29 @@ namespace CodersFileSystem {
 		};
 
 		size_t used = 0;
-		bool usedValid = false;
 		SRef<ByteCountedDeviceListener> byteCountedDeviceListener;
 
 	protected:
+		bool usedValid = false;
+
 		bool checkSizeFunc(long long size, bool addIfAble);
 
+		/*
+		* adds the given change to the tracked used space without checking the capacity,
+		* does nothing if the used space has to get recounted anyway
+		*
+		* @param[in]	delta	the change of used space in bytes
+		*/
+		void addUsed(long long delta);
+
+		/*
+		* counts the used space from scratch,
+		* gets called if the tracked used space got invalidated by one of the listener events not excluded by the listener mask
+		*
+		* @return	the used space
+		*/
+		virtual size_t recountUsed();
+
 		unsigned char listenerMask = 0xFF;
 		SizeCheckFunc checkSize;
 
@@ -132,6 +152,37 @@ namespace CodersFileSystem {
 	};
 
 	class FICSITNETWORKS_API MemDevice : public ByteCountedDevice {
+	private:
+		class MemDevicePathCacheListener : public Listener {
+		private:
+			MemDevice* device;
+
+		public:
+			MemDevicePathCacheListener(MemDevice* device);
+
+			virtual void onNodeRemoved(Path path, NodeType type) override;
+			virtual void onNodeRenamed(Path newPath, Path oldPath, NodeType type) override;
+		};
+
+		static constexpr size_t maxCachedPaths = 1024;
+
+		// resolved nodes by normalized relative path, gets cleared once it is full
+		std::unordered_map<Path, WRef<Node>> pathCache;
+		std::mutex pathCacheMutex;
+		SRef<MemDevicePathCacheListener> pathCacheListener;
+
+		/*
+		* removes the given path and all paths within it from the path cache
+		*
+		* @param[in]	path	the path that got removed or renamed
+		*/
+		void invalidatePathCache(const Path& path);
+
+		/*
+		* resolves the given normalized relative path by walking the directory tree
+		*/
+		SRef<Node> resolve(Path path);
+
 	protected:
 		SRef<MemDirectory> root;
 
@@ -140,6 +191,11 @@ namespace CodersFileSystem {
 
 		virtual size_t getSize() const override;
 
+	protected:
+		virtual size_t recountUsed() override;
+
+	public:
+
 		virtual SRef<FileStream> open(Path path, FileMode mode) override;
 		virtual SRef<Directory> createDir(Path path, bool createTree = false) override;
 		virtual bool remove(Path path, bool recursive = false) override;
@@ -155,8 +211,41 @@ namespace CodersFileSystem {
 		std::filesystem::path realPath;
 		WindowsFileWatcher watcher;
 
+		// used space of every node on disk (name length + file size) by path relative to the real path
+		std::map<std::string, std::uintmax_t> nodeUsage;
+
+		std::string getUsageKey(const std::filesystem::path& path) const;
+
+		/*
+		* stats the given node on disk and updates its entry in the node usage
+		*
+		* @param[in]	path	the real path of the node
+		* @return	the change of used space
+		*/
+		long long indexUsage(const std::filesystem::path& path);
+
+		/*
+		* removes the given node and all its childs from the node usage
+		*
+		* @param[in]	key		the usage key of the node
+		* @return	the change of used space
+		*/
+		long long unindexUsage(const std::string& key);
+
+		/*
+		* updates the tracked used space with the given change event of the watcher
+		*/
+		void updateUsage(int eventType, const Path& to, const Path& from);
+
+		/*
+		* creates a size check function for writes to the file at the given real path,
+		* which also keeps the node usage of the file up to date
+		*/
+		SizeCheckFunc checkSizeFor(const std::filesystem::path& path);
+
 	protected:
 		virtual size_t getSize() const override;
+		virtual size_t recountUsed() override;
 
 	public:
 		DiskDevice(std::filesystem::path realPath, size_t capacity = 0);
@@ -8,6 +8,7 @@
 
 namespace CodersFileSystem {
 	typedef std::function<bool(long long, bool)> SizeCheckFunc;
+	typedef std::function<SizeCheckFunc(const std::filesystem::path&)> SizeCheckFactory;
 
 	class FICSITNETWORKS_API Directory : public Node {
 	public:
@@ -51,10 +52,38 @@ namespace CodersFileSystem {
 	};
 
 	class FICSITNETWORKS_API MemDirectory : public Directory {
+		friend MemFile;
 	protected:
 		std::unordered_map<std::string, SRef<Node>> entries;
 		ListenerListRef listeners;
 		SizeCheckFunc checkSize;
+		MemDirectory* parent = nullptr;
+		size_t size = 0;
+
+		/*
+		* checks and accounts the given change of the size of this directory and all its parents,
+		* the size check function is only used if the directory has no parent
+		*
+		* @param[in]	delta	the change of size in bytes
+		* @return	false if the change exceeds the capacity
+		*/
+		bool resize(long long delta);
+
+		/*
+		* links the given node to this directory as parent
+		*
+		* @param[in]	node	the new child node
+		* @return	the size of the given node
+		*/
+		size_t attach(const SRef<Node>& node);
+
+		/*
+		* unlinks the given node from this directory, so its size no longer counts towards the directory
+		*
+		* @param[in]	node	the removed child node
+		* @return	the size of the given node
+		*/
+		static size_t detach(const SRef<Node>& node);
 
 	public:
 		MemDirectory(ListenerListRef listeners, SizeCheckFunc checkSize);
@@ -88,12 +117,19 @@ namespace CodersFileSystem {
 		* @return	returns true if it was able to add the node to the directory tree
 		*/
 		bool add(const SRef<Node>& node, const std::string& name);
+
+		/*
+		* returns the size of all entries of this directory including their names
+		*
+		* @return	size of the directory
+		*/
+		size_t getSize() const;
 	};
 
 	class FICSITNETWORKS_API DiskDirectory : public Directory {
 	protected:
 		std::filesystem::path realPath;
-		SizeCheckFunc checkSize;
+		SizeCheckFactory checkSize;
 
 		/* Begin Directory-Interface-Implementation */
 		virtual std::unordered_set<std::string> getChilds() const override;
@@ -107,7 +143,7 @@ namespace CodersFileSystem {
 		/* End Directory-Interface-Implementation */
 
 	public:
-		DiskDirectory(const std::filesystem::path& realpath, SizeCheckFunc checkSize);
+		DiskDirectory(const std::filesystem::path& realpath, SizeCheckFactory checkSize);
 		virtual ~DiskDirectory();
 	};
 }
\ No newline at end of file
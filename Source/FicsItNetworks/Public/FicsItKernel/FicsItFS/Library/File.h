@@ -6,9 +6,15 @@
 #include "FileSystem.h"
 #include <sstream>
 #include <fstream>
+#include <memory>
+#include <string_view>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
 
 namespace CodersFileSystem {
 	class MemFileStream;
+	class MemDirectory;
 
 	typedef std::function<bool(long long, bool)> SizeCheckFunc;
 
@@ -32,11 +38,19 @@ namespace CodersFileSystem {
 	};
 
 	class FICSITNETWORKS_API MemFile : public File {
+		friend MemDirectory;
 	private:
 		std::string data;
 		WRef<MemFileStream> io;
 		ListenerListRef listeners;
 		SizeCheckFunc sizeCheck;
+		MemDirectory* parent = nullptr;
+
+		/*
+		* checks and accounts the given change of the content size,
+		* with the parent directory if the file is part of a directory tree, otherwise with the size check function
+		*/
+		bool resize(long long delta, bool addIfAble);
 
 	public:
 		MemFile(ListenerListRef listeners, SizeCheckFunc sizeCheck = [](auto, auto) { return true; });
@@ -69,6 +83,9 @@ namespace CodersFileSystem {
 		FileMode mode;
 	
 	public:
+		// size of the chunks used to read whole streams and of the I/O buffer of disk file streams
+		static constexpr size_t BufferSize = 64 * 1024;
+
 		FileStream(FileMode mode);
 
 		/**
@@ -78,12 +95,32 @@ namespace CodersFileSystem {
 		 */
 		virtual FileMode getMode() const;
 
+		/*
+		* Writes the given data to the current output-stream at the output-stream pos
+		*
+		* @param[in]	data	the data you want to write to the stream
+		* @param[in]	size	the amount of bytes you want to write
+		*/
+		virtual void write(const char* data, size_t size) = 0;
+
 		/*
 		* Writes the given string to the current output-stream at the output-stream pos
 		*
 		* @param[in]	str	the string you want to write to the stream
 		*/
-		virtual void write(std::string str) = 0;
+		void write(std::string_view str);
+
+		/*
+		 * reads up to the given amount of bytes of the input-stream at the current input-stream pos into the given buffer.
+		 * might read less bytes than requested, but stream may still have bytes available later.
+		 *
+		 * If no further bytes are available in filestream, EOF flag will be set and can be checked with the isEOF function.
+		 *
+		 * @param[out]	buffer	the buffer the read bytes get stored in, has to be at least the given size
+		 * @param[in]	size	the amount of bytes you want to read
+		 * @return	the amount of bytes read
+		 */
+		virtual size_t read(char* buffer, size_t size) = 0;
 
 		/*
 		 * reads the given amount of characters of the input-stream at the current input-stream pos.
@@ -94,7 +131,7 @@ namespace CodersFileSystem {
 		 * @param[in]	chars	the count of chars you want to read
 		 * @return	the read chars as string
 		 */
-		virtual std::string read(size_t chars) = 0;
+		std::string read(size_t chars);
 
 		/**
 		 * Returns true if the end-of-file (EOF) flag was set.
@@ -154,8 +191,11 @@ namespace CodersFileSystem {
 		MemFileStream(std::string* data, FileMode mode, ListenerListRef& listeners, SizeCheckFunc sizeCheck = [](auto, auto) { return true; });
 		~MemFileStream();
 
-		virtual void write(std::string str) override;
-		virtual std::string read(size_t chars) override;
+		using FileStream::write;
+		using FileStream::read;
+
+		virtual void write(const char* data, size_t size) override;
+		virtual size_t read(char* buffer, size_t size) override;
 		virtual bool isEOF() override;
 		virtual std::int64_t seek(std::string w, std::int64_t off) override;
 		virtual void close() override;
@@ -167,13 +207,32 @@ namespace CodersFileSystem {
 		std::filesystem::path path;
 		SizeCheckFunc sizeCheck;
 		std::fstream stream;
+		std::unique_ptr<char[]> streamBuffer;
+		std::int64_t size = 0;
+
+		// input only streams read directly from the memory mapped file if the platform supports it,
+		// they see the file as it was when the stream got opened
+		std::unique_ptr<IMappedFileHandle> mappedFile;
+		std::unique_ptr<IMappedFileRegion> mappedRegion;
+		std::int64_t mappedPos = 0;
+		bool mappedEOF = false;
+
+		/*
+		* trys to map the file into memory for reading
+		*
+		* @return	true if the file is mapped and the fstream isn't needed
+		*/
+		bool tryMapFile();
 
 	public:
 		DiskFileStream(std::filesystem::path realPath, FileMode mode, SizeCheckFunc sizeCheck = [](auto, auto) { return true; });
 		~DiskFileStream();
 
-		virtual void write(std::string str) override;
-		virtual std::string read(size_t chars) override;
+		using FileStream::write;
+		using FileStream::read;
+
+		virtual void write(const char* data, size_t length) override;
+		virtual size_t read(char* buffer, size_t length) override;
 		virtual bool isEOF() override;
 		virtual std::int64_t seek(std::string w, std::int64_t off) override;
 		virtual void close() override;
@@ -1,40 +1,70 @@
 #pragma once
 
-#include <regex>
 #include <string>
+#include <string_view>
+#include <functional>
 
 namespace CodersFileSystem {
 	class FICSITNETWORKS_API Path {
 	private:
-		static std::regex sepperatorPattern;
-		static std::regex nodePattern;
+		static constexpr const char* separators = "\\/|";
 		std::string path;
-	
+		// true if the path is known to be in normalized form, so it doesn't need to get normalized again
+		bool normalized = false;
+
+		/*
+		* returns the nodes of the path without the leading slash of absolute paths,
+		* for normalized paths the same for the absolute and relative form
+		*/
+		std::string_view nodes() const {
+			std::string_view view = path;
+			if (view.size() > 0 && view[0] == '/') view.remove_prefix(1);
+			return view;
+		}
+
 	public:
-		static bool isNode(const std::string& str) {
-			return std::regex_match(str, nodePattern);
+		static bool isSeparator(char c) {
+			return c == '/' || c == '\\' || c == '|';
+		}
+
+		/*
+		* checks if the given string is a valid node name,
+		* which is not empty, has no separators and doesn't only consist of '.' and '~'
+		*
+		* @param[in]	str		the string you want to check
+		* @return	true if the string is a valid node name
+		*/
+		static bool isNode(std::string_view str) {
+			bool onlySpecial = true;
+			for (char c : str) {
+				if (isSeparator(c)) return false;
+				if (c != '.' && c != '~') onlySpecial = false;
+			}
+			return !onlySpecial;
 		}
 		
 		Path() = default;
-		Path(const char* path) : Path(std::string(path)) {}
-		Path(std::string str) {
+		Path(const char* path) : Path(std::string_view(path)) {}
+		Path(const std::string& str) : Path(std::string_view(str)) {}
+		Path(std::string_view str) {
 			if (str.size() < 1) return;
 			if (str[0] == '/') path = "/";
-			std::smatch match;
-			while (std::regex_search(str, match, sepperatorPattern)) {
-				if (0 != match.position()) {
-					std::string node = str.substr(0, match.position());
-					append(node);
+			size_t start = 0, sep;
+			while ((sep = str.find_first_of(separators, start)) != std::string_view::npos) {
+				if (sep != start) {
+					append(str.substr(start, sep - start));
 				} else {
 					path = "/";
 				}
-				str = match.suffix();
+				start = sep + 1;
 			}
+			str.remove_prefix(start);
 			if (str.length() < 1 && path.size() > 0 && path[path.size()-1] != '/') path += "/";
 			else append(str);
 		}
 
-		Path& append(std::string node) {
+		Path& append(std::string_view node) {
+			normalized = false;
 			size_t pos = path.find_last_of("/");
 			if (node == ".") {
 				if (pos != path.size()-1) path.append("/");
@@ -80,7 +110,7 @@ namespace CodersFileSystem {
 		
 		bool startsWith(const Path& other) const {
 			Path o = isAbsolute() ? other.absolute() : other.relative();
-			return path.substr(0, o.path.size()) == o.str();
+			return std::string_view(path).substr(0, o.path.size()) == o.path;
 		}
 
 		Path removeFrontNodes(size_t count) const {
@@ -113,12 +143,16 @@ namespace CodersFileSystem {
 		}
 
 		Path normalize() const {
+			if (normalized) return *this;
 			Path newPath;
+			newPath.normalized = true;
+			newPath.path.reserve(path.size());
 			if (isAbsolute()) newPath.path = "/";
+			std::string_view view = path;
 			size_t posEnd, posStart = 0;
 			do {
-				posEnd = path.find_first_of("/", posStart);
-				std::string node = path.substr(posStart, posEnd-posStart);
+				posEnd = view.find_first_of("/", posStart);
+				std::string_view node = view.substr(posStart, posEnd-posStart);
 				posStart = posEnd+1;
 				if (node == ".") {
 				} else if (node == "..") {
@@ -140,22 +174,25 @@ namespace CodersFileSystem {
 		}
 		
 		Path absolute() const {
-			if (isAbsolute()) return normalize();
-			return "/" + normalize().path;
+			Path newPath = normalize();
+			if (!newPath.isAbsolute()) newPath.path.insert(0, "/");
+			return newPath;
 		}
 		
 		Path relative() const {
-			if (isAbsolute()) return normalize().path.substr(1);
-			return normalize();
+			Path newPath = normalize();
+			if (newPath.isAbsolute()) newPath.path.erase(0, 1);
+			return newPath;
 		}
 		
 		Path operator/(const Path& other) const {
 			if (other.isAbsolute()) return other;
 			Path newPath = *this;
+			std::string_view view = other.path;
 			size_t posEnd, posStart = 0;
 			do {
-				posEnd = other.path.find_first_of("/", posStart);
-				newPath.append(other.path.substr(posStart, posEnd-posStart));
+				posEnd = view.find_first_of("/", posStart);
+				newPath.append(view.substr(posStart, posEnd-posStart));
 				posStart = posEnd+1;
 			} while (posEnd != std::string::npos);
 			return newPath;
@@ -166,7 +203,17 @@ namespace CodersFileSystem {
 		}
 
 		bool operator==(const Path& other) const {
-			return relative().str() == other.relative().str();
+			if (normalized && other.normalized) return nodes() == other.nodes();
+			return normalize().nodes() == other.normalize().nodes();
+		}
+
+		/*
+		* returns the hash of the normalized relative form of the path,
+		* so paths equal to each other have the same hash
+		*/
+		size_t hash() const {
+			if (normalized) return std::hash<std::string_view>()(nodes());
+			return std::hash<std::string_view>()(normalize().nodes());
 		}
 
 		bool operator<(const Path& other) const {
@@ -178,3 +225,10 @@ namespace CodersFileSystem {
 		}
 	};
 }
+
+template<>
+struct std::hash<CodersFileSystem::Path> {
+	size_t operator()(const CodersFileSystem::Path& path) const {
+		return path.hash();
+	}
+};
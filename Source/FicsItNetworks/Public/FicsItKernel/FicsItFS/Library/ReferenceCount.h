@@ -1,8 +1,9 @@
 #pragma once
 
 #include <functional>
-#include <mutex>
 #include <atomic>
+#include <type_traits>
+#include <utility>
 
 namespace CodersFileSystem {
 	template<class T>
@@ -12,52 +13,104 @@ namespace CodersFileSystem {
 	template<class T>
 	class WRef;
 
+	/*
+	* Intrusive reference count of objects referenced by SRef and WRef.
+	* The shared count holds the amount of strong references.
+	* The weak count holds the amount of weak references plus one for all strong references together,
+	* so the object gets deleted by whoever releases the last reference of any kind.
+	* An object without strong references stays allocated until the last weak reference is gone,
+	* but weak references no longer resolve to it.
+	*/
 	class ReferenceCounted {
-		template<class T>
+		template<class>
 		friend class Ref;
-		template<class T>
+		template<class>
 		friend class SRef;
-		template<class T>
+		template<class>
 		friend class WRef;
 
 	private:
-		std::atomic<int> weak_count = 0;
+		std::atomic<size_t> weak_count = 0;
 		std::atomic<size_t> shared_count = 0;
 
+		void addShared() {
+			if (shared_count.fetch_add(1, std::memory_order_relaxed) == 0) {
+				weak_count.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		/*
+		* adds a strong reference only if there is at least one strong reference left
+		*
+		* @return	true if the strong reference got added
+		*/
+		bool tryAddShared() {
+			size_t count = shared_count.load(std::memory_order_relaxed);
+			while (count > 0) {
+				if (shared_count.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+			}
+			return false;
+		}
+
+		void releaseShared() {
+			if (shared_count.fetch_sub(1, std::memory_order_acq_rel) == 1) releaseWeak();
+		}
+
+		void addWeak() {
+			weak_count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void releaseWeak() {
+			if (weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+		}
+
+		bool isAlive() const {
+			return shared_count.load(std::memory_order_acquire) > 0;
+		}
+
 	public:
 		virtual ~ReferenceCounted() {}
 	};
 
 	template<class T>
 	class Ref {
-		template<class T>
+		template<class>
+		friend class Ref;
+		template<class>
 		friend class SRef;
-		template<class T>
+		template<class>
 		friend class WRef;
 		friend struct std::hash<CodersFileSystem::WRef<T>>;
 		friend struct std::hash<CodersFileSystem::SRef<T>>;
 
 	protected:
-		ReferenceCounted* ref;
-		std::mutex mutex;
+		T* ptr;
 
-		Ref(T* ref) : ref(dynamic_cast<ReferenceCounted*>(ref)) {
+		Ref(T* ptr) : ptr(ptr) {
 			static_assert(std::is_base_of<ReferenceCounted, T>::value, "T not derived from ReferenceCounted");
 		}
 
-	public:
-		~Ref() {
-			if (ref && ref->shared_count < 1 && ref->weak_count < 1) {
-				delete ref;
-			}
-			ref = nullptr;
+		Ref(const Ref&) = delete;
+		Ref& operator=(const Ref&) = delete;
+
+		static ReferenceCounted* counted(T* ptr) {
+			return ptr;
 		}
 
+		/*
+		* casts the given pointer to T, statically if O is derived from T,
+		* otherwise with a dynamic cast that returns nullptr if the object is no T
+		*/
+		template<class O>
+		static T* cast(O* other) {
+			if constexpr (std::is_convertible<O*, T*>::value) return other;
+			else return dynamic_cast<T*>(other);
+		}
+
+	public:
 		T* get() const {
-			if (!ref) return nullptr;
-			std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mutex));
-			if (ref->shared_count < 1) return nullptr;
-			else return dynamic_cast<T*>(ref);
+			if (!ptr || !counted(ptr)->isAlive()) return nullptr;
+			return ptr;
 		}
 
 		T& operator*() const {
@@ -69,7 +122,7 @@ namespace CodersFileSystem {
 		}
 
 		bool operator<(const Ref& other) const {
-			return ref < other.ref;
+			return ptr < other.ptr;
 		}
 
 		operator T*() const {
@@ -90,29 +143,30 @@ namespace CodersFileSystem {
 	class SRef : public Ref<T> {
 	public:
 		SRef(T* ref = nullptr) : Ref<T>(ref) {
-			static_assert(std::is_base_of<ReferenceCounted, T>::value, "T not derived from ReferenceCounted");
-			if (this->ref) this->ref->shared_count++;
+			if (this->ptr) this->counted(this->ptr)->addShared();
 		}
 
-		SRef(const SRef<T>& other) : SRef(dynamic_cast<T*>(other.get())) {}
+		SRef(const SRef<T>& other) : Ref<T>(other.ptr) {
+			if (this->ptr) this->counted(this->ptr)->addShared();
+		}
+
+		SRef(SRef<T>&& other) noexcept : Ref<T>(other.ptr) {
+			other.ptr = nullptr;
+		}
 
 		template<class O>
-		SRef(const Ref<O>& other) : SRef(dynamic_cast<T*>(other.get())) {}
+		SRef(const Ref<O>& other) : Ref<T>(nullptr) {
+			if (!other.ptr) return;
+			T* ref = Ref<T>::cast(other.ptr);
+			if (ref && this->counted(ref)->tryAddShared()) this->ptr = ref;
+		}
 
 		~SRef() {
-			auto r = Ref<T>::ref;
-			if (r) r->shared_count--;
+			if (this->ptr) this->counted(this->ptr)->releaseShared();
 		}
 
-		SRef& operator=(const SRef& newRef) {
-			if (&newRef == this) return *this;
-			auto r = Ref<T>::get();
-			if (r) r->shared_count--;
-			{
-				std::lock_guard<std::mutex> lock(Ref<T>::mutex);
-				Ref<T>::ref = newRef.get();
-			}
-			if (newRef.ref) Ref<T>::get()->shared_count++;
+		SRef& operator=(SRef newRef) noexcept {
+			std::swap(this->ptr, newRef.ptr);
 			return *this;
 		}
 	};
@@ -121,30 +175,29 @@ namespace CodersFileSystem {
 	class WRef : public Ref<T> {
 	public:
 		WRef(T* ref = nullptr) : Ref<T>(ref) {
-			static_assert(std::is_base_of<ReferenceCounted, T>::value, "T not derived from ReferenceCounted");
-			if (ref) ref->weak_count++;
+			if (this->ptr) this->counted(this->ptr)->addWeak();
 		}
 
-		WRef(const WRef<T>& other) : WRef(dynamic_cast<T*>(other.get())) {}
+		WRef(const WRef<T>& other) : Ref<T>(other.ptr) {
+			if (this->ptr) this->counted(this->ptr)->addWeak();
+		}
+
+		WRef(WRef<T>&& other) noexcept : Ref<T>(other.ptr) {
+			other.ptr = nullptr;
+		}
 
 		template<class O>
-		WRef(const Ref<O>& other) : WRef(dynamic_cast<T*>(other.get())) {}
-
-		WRef& operator=(const WRef& newRef) {
-			if (&newRef == this) return *this;
-			auto r = Ref<T>::get();
-			if (r) r->weak_count--;
-			{
-				std::lock_guard<std::mutex> lock(Ref<T>::mutex);
-				Ref<T>::ref = newRef.get();
-			}
-			if (Ref<T>::get()) Ref<T>::get()->weak_count++;
+		WRef(const Ref<O>& other) : Ref<T>(other.ptr ? Ref<T>::cast(other.ptr) : nullptr) {
+			if (this->ptr) this->counted(this->ptr)->addWeak();
+		}
+
+		WRef& operator=(WRef newRef) noexcept {
+			std::swap(this->ptr, newRef.ptr);
 			return *this;
 		}
 
 		~WRef() {
-			auto r = Ref<T>::ref;
-			if (r) r->weak_count--;
+			if (this->ptr) this->counted(this->ptr)->releaseWeak();
 		}
 	};
 }
@@ -153,14 +206,14 @@ namespace std {
 	template<typename R>
 	struct hash<CodersFileSystem::WRef<R>> {
 		std::size_t operator()(CodersFileSystem::WRef<R> const& o) const noexcept {
-			return std::hash<void*>{}(o.ref);
+			return std::hash<void*>{}(o.ptr);
 		}
 	};
 
 	template<typename R>
 	struct hash<CodersFileSystem::SRef<R>> {
-		std::size_t operator()(CodersFileSystem::WRef<R> const& o) const noexcept {
-			return std::hash<void*>{}(o.ref);
+		std::size_t operator()(CodersFileSystem::SRef<R> const& o) const noexcept {
+			return std::hash<void*>{}(o.ptr);
 		}
 	};
-}
\ No newline at end of file
+}
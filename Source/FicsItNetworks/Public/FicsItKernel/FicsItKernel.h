@@ -80,7 +80,8 @@ private:
 
 	// Cache
 	TSharedPtr<FJsonObject> ReadyToUnpersist = nullptr;
-	TQueue<TSharedPtr<TFINDynamicStruct<FFINFuture>>> FutureQueue;
+	FCriticalSection FutureQueueMutex;
+	TArray<TSharedPtr<TFINDynamicStruct<FFINFuture>>> FutureQueue;
 	TMap<void*, TFunction<void(void*, FReferenceCollector&)>> ReferencedObjects;
 	FFileSystemSerializationInfo FileSystemSerializationInfo;
 	
@@ -195,6 +196,7 @@ public:
 
 	/**
 	 * This function should get executed every main thread tick.
+	 * Resolves all futures queued so far in one batch.
 	 * @note	ONLY FROM THE MAIN THREAD!!!
 	 */
 	void HandleFutures();
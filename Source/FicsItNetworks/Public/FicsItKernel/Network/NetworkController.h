@@ -4,6 +4,7 @@
 #include "Network/FINNetworkComponent.h"
 #include "Network/FINNetworkTrace.h"
 #include "Network/Signals/FINSignalData.h"
+#include "Utils/FINBoundedMPSCQueue.h"
 #include "NetworkController.generated.h"
 
 /**
@@ -13,10 +14,18 @@
 UCLASS()
 class FICSITNETWORKS_API UFINKernelNetworkController : public UObject, public IFGSaveInterface {
 	GENERATED_BODY()
+public:
+	/**
+	 * The maximum amount of signals the signal queue can hold
+	 */
+	static constexpr uint32 MaxSignalCount = 1000;
+	
 protected:
-	FCriticalSection MutexSignals;
-	TArray<TPair<FFINSignalData, FFINNetworkTrace>> SignalQueue;
-	bool bLockSignalReceiving = false;
+	/**
+	 * Signals get pushed by any thread emitting signals and only get popped by the kernel of this controller.
+	 */
+	TFINBoundedMPSCQueue<TPair<FFINSignalData, FFINNetworkTrace>> SignalQueue{MaxSignalCount};
+	std::atomic<bool> bLockSignalReceiving = false;
 
 	/**
 	 * Underlying Computer Network Component used for interacting with the network.
@@ -26,11 +35,6 @@ protected:
 	TScriptInterface<IFINNetworkComponent> Component = nullptr;
 	
 public:
-	/**
-	 * The maximum amount of signals the signal queue can hold
-	 */
-	uint32 MaxSignalCount = 1000;
-
 	// Begin UObject
 	virtual void Serialize(FStructuredArchive::FRecord Record) override;
 	// End UObject
@@ -68,9 +72,20 @@ public:
 	 */
 	FFINSignalData PopSignal(FFINNetworkTrace& OutSender);
 
+	/**
+	 * pops up to the given amount of signals from the queue at once.
+	 * should only get called by the kernel consuming the signals.
+	 *
+	 * @param[out]	OutSignals	array the popped signals and their senders get appended to
+	 * @param[in]	InMaxCount	the maximum amount of signals to pop
+	 * @return	the amount of popped signals
+	 */
+	int32 PopSignals(TArray<TPair<FFINSignalData, FFINNetworkTrace>>& OutSignals, int32 InMaxCount);
+
 	/**
 	 * pushes a signal to the queue.
 	 * signal gets dropped if the queue is already full.
+	 * lock-free, can get called from any thread.
 	 *
 	 * @param[in]	InSignal	the signal you want to push
 	 * @param[in]	InSender	the signal sender of signal you try to push
@@ -79,6 +94,7 @@ public:
 
 	/**
 	 * Removes all signals from the signal queue.
+	 * should only get called by the kernel consuming the signals.
 	 */
 	void ClearSignals();
 
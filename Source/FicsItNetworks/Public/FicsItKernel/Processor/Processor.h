@@ -77,4 +77,10 @@ public:
 	 * Usage and events depend on implementation (f.e. reset on set)
 	 */
 	virtual void SetEEPROM(AFINStateEEPROM* InEEPROM) {}
+
+	/**
+	 * Gets called by the kernel in the main thread after futures of the kernel got resolved.
+	 * Allows the processor to wake up execution that waits for these futures.
+	 */
+	virtual void FuturesResolved() {}
 };
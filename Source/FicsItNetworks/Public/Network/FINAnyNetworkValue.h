@@ -33,86 +33,76 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FINStr& e) {
-		Data.STRING = new FINStr(e);
+		new (Data.STRING.GetTypedPtr()) FINStr(e);
+		Type = FIN_STR;
+	}
+
+	FORCEINLINE FFINAnyNetworkValue(FINStr&& e) {
+		new (Data.STRING.GetTypedPtr()) FINStr(MoveTemp(e));
 		Type = FIN_STR;
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FINObj& e) {
-		Data.OBJECT = new FINObj(e);
+		new (Data.OBJECT.GetTypedPtr()) FINObj(e);
 		Type = FIN_OBJ;
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FINTrace& e) {
-		Data.TRACE = new FINTrace(e);
+		new (Data.TRACE.GetTypedPtr()) TSharedValue<FINTrace>(MakeShared<FINTrace, ESPMode::ThreadSafe>(e));
+		Type = FIN_TRACE;
+	}
+
+	FORCEINLINE FFINAnyNetworkValue(FINTrace&& e) {
+		new (Data.TRACE.GetTypedPtr()) TSharedValue<FINTrace>(MakeShared<FINTrace, ESPMode::ThreadSafe>(MoveTemp(e)));
 		Type = FIN_TRACE;
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FINStruct& e) {
-		Data.STRUCT = new FINStruct(e);
+		new (Data.STRUCT.GetTypedPtr()) TSharedValue<FINStruct>(MakeShared<FINStruct, ESPMode::ThreadSafe>(e));
+		Type = FIN_STRUCT;
+	}
+
+	FORCEINLINE FFINAnyNetworkValue(FINStruct&& e) {
+		new (Data.STRUCT.GetTypedPtr()) TSharedValue<FINStruct>(MakeShared<FINStruct, ESPMode::ThreadSafe>(MoveTemp(e)));
 		Type = FIN_STRUCT;
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FINArray& e) {
-		Data.ARRAY = new FINArray(e);
+		new (Data.ARRAY.GetTypedPtr()) TSharedValue<FINArray>(MakeShared<FINArray, ESPMode::ThreadSafe>(e));
+		Type = FIN_ARRAY;
+	}
+
+	FORCEINLINE FFINAnyNetworkValue(FINArray&& e) {
+		new (Data.ARRAY.GetTypedPtr()) TSharedValue<FINArray>(MakeShared<FINArray, ESPMode::ThreadSafe>(MoveTemp(e)));
 		Type = FIN_ARRAY;
 	}
 
 	FORCEINLINE FFINAnyNetworkValue(const FFINAnyNetworkValue& other) {
-		*this = other;
+		CopyFrom(other);
+	}
+
+	FORCEINLINE FFINAnyNetworkValue(FFINAnyNetworkValue&& other) {
+		MoveFrom(other);
 	}
 
 	FORCEINLINE FFINAnyNetworkValue& operator=(const FFINAnyNetworkValue& other) {
-		this->~FFINAnyNetworkValue();
-		Type = other.Type;
-		switch (Type) {
-		case FIN_STR:
-			Data.STRING = new FINStr(*other.Data.STRING);
-			break;
-		case FIN_OBJ:
-			Data.OBJECT = new FINObj(*other.Data.OBJECT);
-			break;
-		case FIN_TRACE:
-			Data.TRACE = new FINTrace(*other.Data.TRACE);
-			break;
-		case FIN_STRUCT:
-			Data.STRUCT = new FINStruct(*other.Data.STRUCT);
-			break;
-		case FIN_ARRAY:
-			Data.ARRAY = new FINArray(*other.Data.ARRAY);
-			break;
-		case FIN_ANY:
-			Data.ANY = new FINAny(*other.Data.ANY);
-			break;
-		default:
-			Data = other.Data;
-			break;
+		if (this != &other) {
+			Reset();
+			CopyFrom(other);
 		}
 		return *this;
 	}
 
-	FORCEINLINE ~FFINAnyNetworkValue() {
-		switch (Type) {
-		case FIN_STR:
-			delete Data.STRING;
-			break;
-		case FIN_OBJ:
-			delete Data.OBJECT;
-			break;
-		case FIN_TRACE:
-			delete Data.TRACE;
-			break;
-		case FIN_STRUCT:
-			delete Data.STRUCT;
-			break;
-		case FIN_ARRAY:
-			delete Data.ARRAY;
-			break;
-		case FIN_ANY:
-			delete Data.ANY;
-			break;
-		default:
-			break;
+	FORCEINLINE FFINAnyNetworkValue& operator=(FFINAnyNetworkValue&& other) {
+		if (this != &other) {
+			Reset();
+			MoveFrom(other);
 		}
+		return *this;
+	}
+
+	FORCEINLINE ~FFINAnyNetworkValue() {
+		Reset();
 	}
 
 	/**
@@ -183,9 +173,9 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 		case FIN_BOOL:
 			return Data.BOOL;
 		case FIN_OBJ:
-			return (FINBool) Data.OBJECT;
+			return (FINBool) Data.OBJECT.GetTypedPtr()->IsValid();
 		case FIN_TRACE:
-			return (FINBool) Data.TRACE->IsValid();
+			return (FINBool) (*Data.TRACE.GetTypedPtr())->IsValid();
 		default:
 			return false;
 		}
@@ -213,7 +203,7 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	 * @return	the stored string
 	 */
 	FORCEINLINE const FINStr& GetString() const {
-		return *Data.STRING;
+		return *Data.STRING.GetTypedPtr();
 	}
 
 	/**
@@ -225,9 +215,9 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	FORCEINLINE FINObj GetObj() const {
 		switch (GetType()) {
 		case FIN_OBJ:
-			return *Data.OBJECT;
+			return *Data.OBJECT.GetTypedPtr();
 		case FIN_TRACE:
-			return **Data.TRACE;
+			return ***Data.TRACE.GetTypedPtr();
 		default:
 			return nullptr;
 		}
@@ -242,9 +232,9 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	FORCEINLINE FINTrace GetTrace() const {
 		switch (GetType()) {
 		case FIN_TRACE:
-			return *Data.TRACE;
+			return **Data.TRACE.GetTypedPtr();
 		case FIN_OBJ:
-			return FINTrace(Data.OBJECT->Get());
+			return FINTrace(Data.OBJECT.GetTypedPtr()->Get());
 		default:
 			return FINTrace();
 		}
@@ -257,7 +247,7 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	 * @return	the stored struct
 	 */
 	FORCEINLINE const FINStruct& GetStruct() const {
-		return *Data.STRUCT;
+		return **Data.STRUCT.GetTypedPtr();
 	}
 
 	/**
@@ -267,7 +257,7 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	 * @return the stored array
 	 */
 	FORCEINLINE const FINArray& GetArray() const {
-		return *Data.ARRAY;
+		return **Data.ARRAY.GetTypedPtr();
 	}
 
 	/**
@@ -277,26 +267,93 @@ struct FICSITNETWORKS_API FFINAnyNetworkValue {
 	 * @return	the stored trace
 	 */
 	FORCEINLINE const FINAny& GetAny() const {
-		return *Data.ANY;
+		return **Data.ANY.GetTypedPtr();
 	}
 
 	bool Serialize(FStructuredArchive::FSlot Slot);
 
 private:
-	TEnumAsByte<EFINNetworkValueType> Type = FIN_NIL;
+	// traces, structs and arrays are immutable once stored, so copies share the same payload
+	template<typename T>
+	using TSharedValue = TSharedRef<const T, ESPMode::ThreadSafe>;
 	
+	TEnumAsByte<EFINNetworkValueType> Type = FIN_NIL;
+
+	// strings and object references are stored inline, all stored types are bitwise relocatable
 	union {
 		FINInt		INT;
 		FINFloat	FLOAT;
 		FINBool		BOOL;
 		FINClass	CLASS;
-		FINStr*		STRING;
-		FINObj*		OBJECT;
-		FINTrace*	TRACE;
-		FINStruct*	STRUCT;
-		FINArray*	ARRAY;
-		FINAny*		ANY;
+		TTypeCompatibleBytes<FINStr>					STRING;
+		TTypeCompatibleBytes<FINObj>					OBJECT;
+		TTypeCompatibleBytes<TSharedValue<FINTrace>>	TRACE;
+		TTypeCompatibleBytes<TSharedValue<FINStruct>>	STRUCT;
+		TTypeCompatibleBytes<TSharedValue<FINArray>>	ARRAY;
+		TTypeCompatibleBytes<TSharedValue<FINAny>>		ANY;
 	} Data;
+
+	FORCEINLINE void CopyFrom(const FFINAnyNetworkValue& other) {
+		switch (other.Type) {
+		case FIN_STR:
+			new (Data.STRING.GetTypedPtr()) FINStr(*other.Data.STRING.GetTypedPtr());
+			break;
+		case FIN_OBJ:
+			new (Data.OBJECT.GetTypedPtr()) FINObj(*other.Data.OBJECT.GetTypedPtr());
+			break;
+		case FIN_TRACE:
+			new (Data.TRACE.GetTypedPtr()) TSharedValue<FINTrace>(*other.Data.TRACE.GetTypedPtr());
+			break;
+		case FIN_STRUCT:
+			new (Data.STRUCT.GetTypedPtr()) TSharedValue<FINStruct>(*other.Data.STRUCT.GetTypedPtr());
+			break;
+		case FIN_ARRAY:
+			new (Data.ARRAY.GetTypedPtr()) TSharedValue<FINArray>(*other.Data.ARRAY.GetTypedPtr());
+			break;
+		case FIN_ANY:
+			new (Data.ANY.GetTypedPtr()) TSharedValue<FINAny>(*other.Data.ANY.GetTypedPtr());
+			break;
+		default:
+			Data = other.Data;
+			break;
+		}
+		Type = other.Type;
+	}
+
+	FORCEINLINE void MoveFrom(FFINAnyNetworkValue& other) {
+		FMemory::Memcpy(&Data, &other.Data, sizeof(Data));
+		Type = other.Type;
+		other.Type = FIN_NIL;
+	}
+
+	FORCEINLINE void Reset() {
+		switch (Type) {
+		case FIN_STR:
+			DestructItem(Data.STRING.GetTypedPtr());
+			break;
+		case FIN_OBJ:
+			DestructItem(Data.OBJECT.GetTypedPtr());
+			break;
+		case FIN_TRACE:
+			DestructItem(Data.TRACE.GetTypedPtr());
+			break;
+		case FIN_STRUCT:
+			DestructItem(Data.STRUCT.GetTypedPtr());
+			break;
+		case FIN_ARRAY:
+			DestructItem(Data.ARRAY.GetTypedPtr());
+			break;
+		case FIN_ANY:
+			DestructItem(Data.ANY.GetTypedPtr());
+			break;
+		default:
+			break;
+		}
+		Type = FIN_NIL;
+	}
+
+	template<typename T>
+	static void SerializeSharedValue(FStructuredArchive::FSlot Slot, TTypeCompatibleBytes<TSharedValue<T>>& Value);
 };
 
 FORCEINLINE void operator<<(FStructuredArchive::FSlot Slot, FFINAnyNetworkValue& AnyValue) {
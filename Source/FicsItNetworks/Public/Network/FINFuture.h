@@ -2,6 +2,7 @@
 
 #include "Reflection/FINFunction.h"
 #include "FicsItNetworksModule.h"
+#include <atomic>
 #include "FINFuture.generated.h"
 
 USTRUCT(BlueprintType)
@@ -21,6 +22,13 @@ struct FICSITNETWORKS_API FFINFuture {
 	 */
 	virtual bool IsDone() const { return false; }
 
+	/**
+	 * Returns true if the future is done once the kernel executed it,
+	 * so anyone waiting for it can get woken when the kernel resolved its futures.
+	 * Futures like http requests only get started by the execution and finish later on their own.
+	 */
+	virtual bool IsResolvedOnExecute() const { return false; }
+
 	/**
 	 * Returns the output data of the future
 	 */
@@ -31,6 +39,9 @@ USTRUCT()
 struct FICSITNETWORKS_API FFINFutureReflection : public FFINFuture {
 	GENERATED_BODY()
 
+	/**
+	 * Saved state of the future, the runtime state is bResolved.
+	 */
 	UPROPERTY(SaveGame)
 	bool bDone = false;
 
@@ -49,61 +60,102 @@ struct FICSITNETWORKS_API FFINFutureReflection : public FFINFuture {
 	UPROPERTY(SaveGame)
 	UFINProperty* Property = nullptr;
 
-	static FCriticalSection Mutex;
+	/**
+	 * Gets set by the main thread once the output is written.
+	 * Afterwards the future is immutable and can be read by any thread without locking.
+	 */
+	std::atomic<bool> bResolved = false;
 
 	// TODO: Maybe do a LogScope snapshot?
 	FFINFutureReflection() = default;
-	FFINFutureReflection(UFINFunction* Function, const FFINExecutionContext& Context, const TArray<FFINAnyNetworkValue>& Input) : Input(Input), Context(Context), Function(Function) {}
+	FFINFutureReflection(UFINFunction* Function, const FFINExecutionContext& Context, TArray<FFINAnyNetworkValue> Input) : Input(MoveTemp(Input)), Context(Context), Function(Function) {}
 	FFINFutureReflection(UFINProperty* Property, const FFINExecutionContext& Context, const FFINAnyNetworkValue& Input) : Input({Input}), Context(Context), Property(Property) {}
 	FFINFutureReflection(UFINProperty* Property, const FFINExecutionContext& Context) : Context(Context), Property(Property) {}
+	FFINFutureReflection(const FFINFutureReflection& Other) : FFINFuture(Other), bDone(Other.bDone), Input(Other.Input), Output(Other.Output), Context(Other.Context), Function(Other.Function), Property(Other.Property), bResolved(Other.bResolved.load()) {}
+
+	FFINFutureReflection& operator=(const FFINFutureReflection& Other) {
+		FFINFuture::operator=(Other);
+		bDone = Other.bDone;
+		Input = Other.Input;
+		Output = Other.Output;
+		Context = Other.Context;
+		Function = Other.Function;
+		Property = Other.Property;
+		bResolved = Other.bResolved.load();
+		return *this;
+	}
+
+	void PostSerialize(const FArchive& Ar) {
+		if (Ar.IsLoading()) bResolved = bDone;
+	}
 
 	virtual bool IsDone() const override {
-		FScopeLock Lock(const_cast<FCriticalSection*>(&Mutex));
-		return bDone;
+		return bResolved.load(std::memory_order_acquire);
 	}
 
-	virtual void Execute() override {
-		FScopeLock Lock(&Mutex);
+	virtual bool IsResolvedOnExecute() const override { return true; }
 
+	virtual void Execute() override {
+		if (IsDone()) return;
+		
 		if (!Context.IsValid()) {
 			throw FFINException(TEXT("Execution context of future is invalid."));
 		}
 		
 		if (Function) {
 			Output = Function->Execute(Context, Input);
-			bDone = true;
 		} else if (Property) {
 			if (Input.Num() > 0) {
 				Property->SetValue(Context, Input[0]);
 			} else {
 				Output.Add(Property->GetValue(Context));
-				bDone = true;
 			}
 		} else {
 			UE_LOG(LogFicsItNetworks, Error, TEXT("Future unable to get executed due to invalid function/property pointer!"));
+			// resolve without output, so nothing waits for it forever
 		}
+		bDone = true;
+		bResolved.store(true, std::memory_order_release);
 	}
 
 	virtual TArray<FFINAnyNetworkValue> GetOutput() const override {
-		FScopeLock Lock(const_cast<FCriticalSection*>(&Mutex));
+		if (!IsDone()) return {};
 		return Output;
 	}
 };
 
+template<>
+struct TStructOpsTypeTraits<FFINFutureReflection> : public TStructOpsTypeTraitsBase2<FFINFutureReflection> {
+	enum {
+		WithCopy = true,
+		WithPostSerialize = true,
+	};
+};
+
 USTRUCT()
 struct FICSITNETWORKS_API FFINFunctionFuture : public FFINFuture {
 	GENERATED_BODY()
 
 	TFunction<void()> Func;
-	bool bDone = false;
+	std::atomic<bool> bDone = false;
 
 	FFINFunctionFuture() = default;
 	FFINFunctionFuture(TFunction<void()> Func) : Func(Func) {}
+	FFINFunctionFuture(const FFINFunctionFuture& Other) : FFINFuture(Other), Func(Other.Func), bDone(Other.bDone.load()) {}
+
+	FFINFunctionFuture& operator=(const FFINFunctionFuture& Other) {
+		FFINFuture::operator=(Other);
+		Func = Other.Func;
+		bDone = Other.bDone.load();
+		return *this;
+	}
 
 	virtual void Execute() override {
-		bDone = true;
 		Func();
+		bDone.store(true, std::memory_order_release);
 	}
 
-	virtual bool IsDone() const override { return bDone; }
+	virtual bool IsDone() const override { return bDone.load(std::memory_order_acquire); }
+
+	virtual bool IsResolvedOnExecute() const override { return true; }
 };
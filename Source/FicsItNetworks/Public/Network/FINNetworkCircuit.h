@@ -6,6 +6,20 @@
 #include "FINNetworkCircuit.generated.h"
 
 class UFINAdvancedNetworkConnectionComponent;
+class IFINNetworkMessageInterface;
+
+/**
+ * Holds the values a node got indexed with by a circuit,
+ * needed to remove the node from the indices again even if the values of the node changed.
+ */
+struct FFINNetworkCircuitIndexEntry {
+	int32 NodeIndex = INDEX_NONE;
+	FGuid ID;
+	TArray<FString> NickTokens;
+	UClass* Class = nullptr;
+	UClass* RedirectClass = nullptr;
+	bool bIsComponent = false;
+};
 
 /**
  * Manages and caches a computer network circuit.
@@ -18,10 +32,54 @@ class FICSITNETWORKS_API AFINNetworkCircuit : public AActor {
 	friend UFINAdvancedNetworkConnectionComponent;
 
 protected:
-	UPROPERTY(Replicated)
+	UPROPERTY(ReplicatedUsing=OnRep_Nodes)
 	TArray<UObject*> Nodes;
 
-	void AddNodeRecursive(TArray<TScriptInterface<IFINNetworkCircuitNode>>& Added, TScriptInterface<IFINNetworkCircuitNode> Add);
+	/**
+	 * Lookup indices of the circuit cache.
+	 * Get incrementally updated whenever nodes get added, updated or the cache gets cleared.
+	 */
+	TMap<TWeakObjectPtr<UObject>, FFINNetworkCircuitIndexEntry> IndexedNodes;
+	TSet<TWeakObjectPtr<UObject>> ComponentIndex;
+	TMap<FGuid, TWeakObjectPtr<UObject>> IDIndex;
+	TMap<FString, TSet<TWeakObjectPtr<UObject>>> NickIndex;
+	TMap<UClass*, TSet<TWeakObjectPtr<UObject>>> ClassIndex;
+	TMap<UClass*, TSet<TWeakObjectPtr<UObject>>> RedirectClassIndex;
+	TSet<TWeakObjectPtr<UObject>> MessageEndpointIndex;
+
+	/**
+	 * Components which had no valid ID yet when they got indexed.
+	 * They get indexed by ID with the next ID lookup.
+	 */
+	TSet<TWeakObjectPtr<UObject>> PendingIDIndex;
+
+	/**
+	 * Adds the given node and every node reachable from it to the circuit cache.
+	 */
+	void AddNodesConnectedTo(UObject* Start);
+
+	/**
+	 * Adds the given node to the circuit cache and its indices.
+	 * Does nothing if the node is already part of the cache.
+	 */
+	void AddNode(UObject* Node);
+
+	/**
+	 * Removes the given node from the circuit cache and its indices.
+	 */
+	void RemoveNode(UObject* Node);
+
+	/**
+	 * Removes all nodes from the circuit cache and clears all indices.
+	 */
+	void ClearNodes();
+
+	void IndexNode(UObject* Node, int32 NodeIndex);
+	void UnindexNode(UObject* Node);
+	void IndexPendingIDs();
+
+	UFUNCTION()
+	void OnRep_Nodes();
 
 public:
 	AFINNetworkCircuit();
@@ -38,6 +96,12 @@ public:
 	 */
 	void Recalculate(const TScriptInterface<IFINNetworkCircuitNode>& Node);
 
+	/**
+	 * Updates the lookup indices of the given node.
+	 * Should get called when the ID, nick or instance redirect of a node in the circuit changes.
+	 */
+	void UpdateNode(UObject* Node);
+
 	/**
 	 * Returns if the given node is part of the circuit based on the circuit cache
 	 */
@@ -63,12 +127,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Network|Circuit")
 	TSet<UObject*> FindComponentsByNick(const FString& Nick, const TScriptInterface<IFINNetworkComponent>& Requester);
 
+	/**
+	 * Trys to find components of the given class in the circuit cache.
+	 *
+	 * @param[in]	Class		the class the components need to be a child of
+	 * @param[in]	bRedirect	if true, the class of the instance redirect of the components gets checked instead of the class of the components
+	 * @param[in]	Requester	the reference to the requesting component, if set, enables permitted access filtering
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Network|Circuit")
+	TSet<UObject*> FindComponentsByClass(UClass* Class, bool bRedirect, const TScriptInterface<IFINNetworkComponent>& Requester);
+
 	/**
 	 * Returns all components in the circuit cache.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Network|Circuit")
 	TSet<UObject*> GetComponents();
 
+	/**
+	 * Calls the given function for every component in the circuit cache able to handle network messages.
+	 *
+	 * @param[in]	bRoutersOnly	if true, only network message routers get passed to the function
+	 * @param[in]	Func			the function getting called for every endpoint
+	 * @return	the amount of endpoints the function got called for
+	 */
+	int32 ForEachMessageEndpoint(bool bRoutersOnly, TFunctionRef<void(IFINNetworkMessageInterface*)> Func);
+
 	/**
 	 * Checks if the given node is part of the circuit started by the given node based on the circuit connections.
 	 * @warning	slow! You should use HasNode since it uses the cache.
@@ -79,7 +162,8 @@ public:
 	/**
 	 * Updates the circuits of node A and B after node B got removed
 	 * from the circuit of node A
-	 * by creating the new circuit, recalculating the circuits etc.
+	 * by moving the nodes which are no longer reachable into a new circuit.
+	 * Only the smaller one of the two sides gets traversed and moved.
 	 * Should get called after the the nodes got disconnected
 	 *
 	 * @param[in]	A	the node whichs circuit should remove node B
@@ -101,4 +185,16 @@ public:
 
 private:
 	static bool IsNodeConnected_Internal(const TScriptInterface<IFINNetworkCircuitNode>& Self, const TScriptInterface<IFINNetworkCircuitNode>& Node, TSet<UObject*>& Searched);
+
+	/**
+	 * Searches from both given nodes at the same time, one node per side and step,
+	 * until either the searches meet or one side has no nodes left to visit.
+	 * This way the search only costs as much as the smaller side, if the nodes are no longer connected.
+	 *
+	 * @param[in]	A			the first node
+	 * @param[in]	B			the second node
+	 * @param[out]	OutSeparated	all nodes of the smaller side, if the nodes are no longer connected
+	 * @return	true if the nodes are no longer connected
+	 */
+	static bool FindSeparatedNodes(UObject* A, UObject* B, TSet<UObject*>& OutSeparated);
 };
\ No newline at end of file
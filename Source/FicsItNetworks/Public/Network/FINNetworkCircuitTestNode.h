@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FINNetworkCircuitNode.h"
+#include "FINNetworkComponent.h"
+#include "FINNetworkCircuitTestNode.generated.h"
+
+/**
+ * Circuit node without any game logic, used by the network circuit tests to build synthetic circuits.
+ * Is no network component, like a cable or connector.
+ */
+UCLASS(Transient, NotBlueprintable)
+class FICSITNETWORKS_API UFINNetworkCircuitTestConnector : public UObject, public IFINNetworkCircuitNode {
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	TSet<UObject*> Connected;
+
+	UPROPERTY()
+	AFINNetworkCircuit* Circuit = nullptr;
+
+	// Begin IFINNetworkCircuitNode
+	virtual TSet<UObject*> GetConnected_Implementation() const override;
+	virtual AFINNetworkCircuit* GetCircuit_Implementation() const override;
+	virtual void SetCircuit_Implementation(AFINNetworkCircuit* InCircuit) override;
+	virtual void NotifyNetworkUpdate_Implementation(int32 Type, const TSet<UObject*>& Nodes) override;
+	// End IFINNetworkCircuitNode
+};
+
+/**
+ * Network component without any game logic, used by the network circuit tests to build synthetic circuits.
+ */
+UCLASS(Transient, NotBlueprintable)
+class FICSITNETWORKS_API UFINNetworkCircuitTestNode : public UFINNetworkCircuitTestConnector, public IFINNetworkComponent {
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	FGuid ID;
+
+	UPROPERTY()
+	FString Nick;
+
+	UPROPERTY()
+	UObject* Redirect = nullptr;
+
+	// Begin IFINNetworkComponent
+	virtual FGuid GetID_Implementation() const override;
+	virtual FString GetNick_Implementation() const override;
+	virtual void SetNick_Implementation(const FString& InNick) override;
+	virtual bool HasNick_Implementation(const FString& InNick) override;
+	virtual UObject* GetInstanceRedirect_Implementation() override;
+	virtual bool AccessPermitted_Implementation(FGuid InID) const override;
+	// End IFINNetworkComponent
+};
+
+/**
+ * Second network component class, so the tests are able to look up components by class.
+ */
+UCLASS(Transient, NotBlueprintable)
+class FICSITNETWORKS_API UFINNetworkCircuitTestNodeVariant : public UFINNetworkCircuitTestNode {
+	GENERATED_BODY()
+};
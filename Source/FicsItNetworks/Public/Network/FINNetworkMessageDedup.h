@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Remembers the IDs of recently handled network messages, so routers and receivers
+ * handle every message only once even if it reaches them on multiple paths.
+ *
+ * IDs are forgotten once they are older than the time window,
+ * or once the capacity is reached, starting with the oldest one.
+ * Thread safe.
+ */
+class FICSITNETWORKS_API FFINNetworkMessageDedup {
+	struct FEntry {
+		FGuid ID;
+		double Time = 0.0;
+	};
+
+	FCriticalSection Mutex;
+	TArray<FEntry> Entries;
+	TSet<FGuid> IDs;
+	int32 Head = 0;
+	int32 Num = 0;
+	double Window;
+
+	void EvictOldest();
+
+public:
+	static constexpr int32 DefaultCapacity = 1024;
+	static constexpr double DefaultWindow = 1.0;
+
+	explicit FFINNetworkMessageDedup(int32 InCapacity = DefaultCapacity, double InWindow = DefaultWindow);
+
+	/**
+	 * Marks the given message as handled.
+	 *
+	 * @param[in]	ID	the ID of the message
+	 * @return	false if the message has already been handled within the time window
+	 */
+	bool TryAdd(const FGuid& ID);
+
+	/**
+	 * Forgets all handled messages
+	 */
+	void Reset();
+};
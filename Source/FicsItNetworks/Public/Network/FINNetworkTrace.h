@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <atomic>
 #include "FINNetworkTrace.generated.h"
 
 /**
@@ -12,7 +13,8 @@ typedef TFunction<bool(UObject*, UObject*)> FFINTraceStep;
 
 /**
  * Tracks the access of a object through the network.
- * Allows a later check if the object is still reachable
+ * Allows a later check if the object is still reachable.
+ * The previous traces are immutable and shared between all copies of a trace.
  */
 USTRUCT(BlueprintType)
 struct FICSITNETWORKS_API FFINNetworkTrace {
@@ -21,12 +23,17 @@ struct FICSITNETWORKS_API FFINNetworkTrace {
 	friend uint32 GetTypeHash(const FFINNetworkTrace&);
 
 private:
-	TSharedPtr<FFINNetworkTrace> Prev = nullptr;
+	TSharedPtr<const FFINNetworkTrace, ESPMode::ThreadSafe> Prev = nullptr;
 	TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> Step = nullptr;
 
 	UPROPERTY()
 	UObject* Obj = nullptr;
 
+	// the validation epoch in which this trace was last found to be valid
+	mutable std::atomic<uint32> ValidEpoch = 0;
+
+	static std::atomic<uint32> ValidationEpoch;
+
 public:
 	static TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> fallbackTraceStep;
 	static TArray<TPair<TPair<UClass*, UClass*>, TPair<FString, FFINTraceStep*>>(*)()> toRegister;
@@ -39,6 +46,12 @@ public:
 	 * Trys to find the most suitable trace step of for both given classes
 	 */
 	static TSharedPtr<FFINTraceStep, ESPMode::ThreadSafe> findTraceStep(UClass* A, UClass* B);
+
+	/**
+	 * Starts a new validation epoch, so all traces get validated again on their next check.
+	 * Has to get called whenever the network or object graph changes in a way that might invalidate a trace.
+	 */
+	static void InvalidateValidationCache();
 	
 	FFINNetworkTrace(const FFINNetworkTrace& trace);
 	FFINNetworkTrace& operator=(const FFINNetworkTrace& trace);
@@ -100,6 +113,7 @@ public:
 	/**
 	 * Executes the step function of it self and cascades the steps of the previous traces.
 	 * If no step is found just does the previous traces.
+	 * The steps only get executed again if the trace wasn't already found to be valid in the current validation epoch.
 	 */
 	bool IsValid() const;
 
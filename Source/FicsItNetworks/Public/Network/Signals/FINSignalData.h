@@ -12,13 +12,23 @@ struct FICSITNETWORKS_API FFINSignalData {
 	UPROPERTY()
 	UFINSignal* Signal = nullptr;
 
-	UPROPERTY()
-	TArray<FFINAnyNetworkValue> Data;
-
 	FFINSignalData() = default;
-	FFINSignalData(UFINSignal* Signal, const FINArray& Data) : Signal(Signal), Data(Data) {}
+	FFINSignalData(UFINSignal* Signal, const FINArray& Data) : Signal(Signal), Data(MakeShared<FINArray, ESPMode::ThreadSafe>(Data)) {}
+	FFINSignalData(UFINSignal* Signal, FINArray&& Data) : Signal(Signal), Data(MakeShared<FINArray, ESPMode::ThreadSafe>(MoveTemp(Data))) {}
+
+	/**
+	 * Returns the parameters of the signal
+	 */
+	const FINArray& GetData() const {
+		static const FINArray EmptyData;
+		return Data.IsValid() ? *Data : EmptyData;
+	}
 
 	bool Serialize(FStructuredArchive::FSlot Slot);
+
+private:
+	// the parameters are immutable, so all receivers of a signal share them
+	TSharedPtr<const FINArray, ESPMode::ThreadSafe> Data;
 };
 
 inline FArchive& operator<<(FArchive& Ar, FFINSignalData& Data) {
@@ -12,6 +12,14 @@ struct FICSITNETWORKS_API FFINSignalListeners {
 	UPROPERTY(SaveGame)
 	TArray<FFINNetworkTrace> Listeners;
 
+	// the reversed listener traces pointing from the receiver back to the sender, same order as the listeners
+	TArray<FFINNetworkTrace> ReversedListeners;
+
+	/**
+	 * Reverses all listener traces again
+	 */
+	void UpdateReversedListeners();
+
 	void AddStructReferencedObjects(FReferenceCollector& ReferenceCollector) const;
 };
 
@@ -64,7 +72,8 @@ public:
     static AFINSignalSubsystem* GetSignalSubsystem(UObject* WorldContext);
 
 	/**
-	 * Distributes the given signal to all listeners listening to the given object
+	 * Distributes the given signal to all listeners listening to the given object.
+	 * All listeners share the same signal data.
 	 */
 	void BroadcastSignal(UObject* Sender, const FFINSignalData& Signal);
 
@@ -7,7 +7,10 @@
 class AFINWirelessAccessPoint;
 
 /**
- * Subsystem to recalculate wireless network topology on changes
+ * Subsystem to recalculate wireless network topology on changes.
+ *
+ * The radar towers are kept in a grid on the XY plane, so changes only re-link
+ * the access points whose towers are in reach of the changed tower.
  */
 UCLASS()
 class FICSITNETWORKS_API AFINWirelessSubsystem : public AModSubsystem {
@@ -27,9 +30,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Network|Wireless")
 	TArray<AFINWirelessAccessPoint*> GetAccessPoints();
 
+	/**
+	 * Rebuilds the tower index from the world and re-links all access points
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Network|Wireless")
 	void RecalculateWirelessConnections();
 
+	/**
+	 * Adds the given radar tower to the index and re-links the access points in its reach
+	 */
+	void AddRadarTower(AFGBuildableRadarTower* Tower);
+
+	/**
+	 * Removes the given radar tower from the index and re-links the access points in its reach
+	 */
+	void RemoveRadarTower(AFGBuildableRadarTower* Tower);
+
+	/**
+	 * Adds the given access point and links it and the access points in its reach
+	 */
+	void AddAccessPoint(AFINWirelessAccessPoint* AccessPoint);
+
+	/**
+	 * Removes the given access point and re-links the access points in its reach
+	 */
+	void RemoveAccessPoint(AFINWirelessAccessPoint* AccessPoint);
+
 	/**
 	 * Identifies the connections to other Wireless Access Points or Radar Towers
 	 * with detailed information for each of them
@@ -46,4 +72,34 @@ public:
 protected:
 	virtual void BeginPlay() override;
 	void CacheTowersAndAccessPoints();
+
+private:
+	// Edge length of the cells of the tower grid
+	static constexpr float GridCellSize = 212000.0f;
+
+	// Radar towers in each cell of the grid, only maintained on the host
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AFGBuildableRadarTower>>> TowerGrid;
+	TMap<TWeakObjectPtr<AFGBuildableRadarTower>, FIntPoint> TowerCells;
+	TMap<TWeakObjectPtr<AFGBuildableRadarTower>, TWeakObjectPtr<AFINWirelessAccessPoint>> TowerAccessPoints;
+	bool bIndexBuilt = false;
+
+	static FIntPoint GetGridCell(const FVector& Location);
+
+	/**
+	 * Calls the given function for every indexed tower within the given XY distance of the given location
+	 */
+	void ForEachTowerInReach(const FVector& Location, float Reach, TFunctionRef<void(AFGBuildableRadarTower*)> Func);
+
+	void IndexRadarTower(AFGBuildableRadarTower* Tower);
+	void UnindexRadarTower(AFGBuildableRadarTower* Tower);
+
+	/**
+	 * Re-links all access points attached to towers whose range might overlap with a tower at the given location
+	 */
+	void UpdateConnectionsAround(const FVector& Location);
+
+	/**
+	 * Re-links the given access point to all access points in direct range, reusing its connection objects
+	 */
+	void UpdateAccessPointConnections(AFINWirelessAccessPoint* AccessPoint);
 };
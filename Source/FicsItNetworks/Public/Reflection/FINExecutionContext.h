@@ -29,45 +29,22 @@ public:
 
 	FORCEINLINE FFINExecutionContext(const FFINNetworkTrace& InTrace) {
 		Type = TRACE;
-		Trace = new FFINNetworkTrace(InTrace);
+		new (Trace.GetTypedPtr()) FFINNetworkTrace(InTrace);
 	}
 
 	FORCEINLINE FFINExecutionContext(const FFINExecutionContext& Other) {
-		Type = GENERIC;
-		*this = Other;
+		CopyFrom(Other);
 	}
 
 	FORCEINLINE ~FFINExecutionContext() {
-		switch (Type) {
-		case TRACE:
-			delete Trace;
-			break;
-		default: ;
-		}
+		Reset();
 	}
 	
 	FORCEINLINE FFINExecutionContext& operator=(const FFINExecutionContext& Other) {
-		switch (Type) {
-		case TRACE:
-			delete Trace;
-			break;
-		default: ;
-		}
-
-		Type = Other.Type;
-		switch (Type) {
-		case GENERIC:
-			Generic = Other.Generic;
-			break;
-		case OBJECT:
-			Obj = Other.Obj;
-			break;
-		case TRACE:
-			Trace = new FFINNetworkTrace(*Other.Trace);
-			break;
-		default: ;
+		if (this != &Other) {
+			Reset();
+			CopyFrom(Other);
 		}
-		
 		return *this;
 	}
 
@@ -82,7 +59,7 @@ public:
 		case OBJECT:
 			return Obj;
 		case TRACE:
-			return **Trace;
+			return **GetTracePtr();
 		default: ;
 		}
 		return nullptr;
@@ -93,7 +70,7 @@ public:
 		case OBJECT:
 			return Obj;
 		case TRACE:
-			return **Trace;
+			return **GetTracePtr();
 		default: ;
 		}
 		return nullptr;
@@ -104,7 +81,7 @@ public:
 		case OBJECT:
 			return FFINNetworkTrace(Obj);
 		case TRACE:
-			return *Trace;
+			return *GetTracePtr();
 		default: ;
 		}
 		return FFINNetworkTrace();
@@ -117,7 +94,7 @@ public:
 		case OBJECT:
 			return Obj != nullptr;
 		case TRACE:
-			return Trace->IsValid();
+			return GetTracePtr()->IsValid();
 		default: ;
 		}
 		return false;
@@ -127,12 +104,14 @@ public:
 		FStructuredArchive::FRecord Record = Slot.EnterRecord();
 		TOptional<FStructuredArchive::FSlot> TraceField = Record.TryEnterField(SA_FIELD_NAME(TEXT("Trace")), Type == TRACE);
 		if (TraceField.IsSet()) {
-			if (Type != TRACE) Trace = new FFINNetworkTrace();
-			Type = TRACE;
-			Trace->Serialize(TraceField.GetValue());
+			if (Type != TRACE) {
+				new (Trace.GetTypedPtr()) FFINNetworkTrace();
+				Type = TRACE;
+			}
+			Trace.GetTypedPtr()->Serialize(TraceField.GetValue());
 			return true;
 		} else if (Type == TRACE) {
-			delete Trace;
+			Reset();
 		}
 
 		TOptional<FStructuredArchive::FSlot> ObjectField = Record.TryEnterField(SA_FIELD_NAME(TEXT("Object")), Type == OBJECT);
@@ -148,12 +127,38 @@ public:
 	
 private:
 	Type Type;
-	
+
+	// the trace is stored inline, so trace contexts don't need a heap allocation
 	union {
 		void* Generic;
 		UObject* Obj;
-		FFINNetworkTrace* Trace;
+		TTypeCompatibleBytes<FFINNetworkTrace> Trace;
 	};
+
+	FORCEINLINE const FFINNetworkTrace* GetTracePtr() const {
+		return Trace.GetTypedPtr();
+	}
+
+	FORCEINLINE void CopyFrom(const FFINExecutionContext& Other) {
+		Type = Other.Type;
+		switch (Type) {
+		case GENERIC:
+			Generic = Other.Generic;
+			break;
+		case OBJECT:
+			Obj = Other.Obj;
+			break;
+		case TRACE:
+			new (Trace.GetTypedPtr()) FFINNetworkTrace(*Other.GetTracePtr());
+			break;
+		default: ;
+		}
+	}
+
+	FORCEINLINE void Reset() {
+		if (Type == TRACE) DestructItem(Trace.GetTypedPtr());
+		Type = NONE;
+	}
 };
 
 inline FArchive& operator<<(FArchive& Ar, FFINExecutionContext& Ctx) {
@@ -3,6 +3,7 @@
 #include "FINExecutionContext.h"
 #include "FINProperty.h"
 #include "FINReflectionException.h"
+#include <atomic>
 #include "FINFunction.generated.h"
 
 #define FIN_Operator_Add operatorAdd
@@ -59,6 +60,15 @@ struct FICSITNETWORKS_API FFINFunctionBadArgumentException : public FFINReflecti
 	FFINFunctionBadArgumentException(UFINFunction* Func, int ArgumentIndex, const FString& Message) : FFINReflectionException(Cast<UFINBase>(Func), Message), ArgumentIndex(ArgumentIndex) {}
 };
 
+/**
+ * The parameters of a function split into the parameters that get passed to it and the parameters it returns,
+ * so calls don't have to filter the parameter list each time.
+ */
+struct FFINFunctionCallLayout {
+	TArray<UFINProperty*> InputParameters;
+	TArray<UFINProperty*> OutputParameters;
+};
+
 UCLASS(BlueprintType)
 class FICSITNETWORKS_API UFINFunction : public UFINBase {
 	GENERATED_BODY()
@@ -85,4 +95,20 @@ public:
 	 * Executes the function with the given properties and the given Ctx
 	 */
 	virtual TArray<FFINAnyNetworkValue> Execute(const FFINExecutionContext& Ctx, const TArray<FFINAnyNetworkValue>& Params) const;
+
+	/**
+	 * Returns the input and output parameters of this function.
+	 * Gets built on first use, the parameters must not change afterwards.
+	 */
+	const FFINFunctionCallLayout& GetCallLayout() const {
+		if (!bCallLayoutBuilt.load(std::memory_order_acquire)) BuildCallLayout();
+		return CallLayout;
+	}
+
+private:
+	mutable FFINFunctionCallLayout CallLayout;
+	mutable std::atomic<bool> bCallLayoutBuilt = false;
+	mutable FCriticalSection CallLayoutMutex;
+
+	void BuildCallLayout() const;
 };
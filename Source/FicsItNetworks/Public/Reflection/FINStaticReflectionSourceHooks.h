@@ -16,8 +16,44 @@
 #include "FGCharacterPlayer.h"
 #include "FGLocomotive.h"
 #include "Buildables/FGBuildableRailroadStation.h"
+#include <atomic>
 #include "FINStaticReflectionSourceHooks.generated.h"
 
+/**
+ * Lock-free filter in front of the sender set of function hooks.
+ * Hooked functions run for every object of the hooked class, most of them don't have any listener,
+ * so the filter allows to skip them without taking the lock of the sender set.
+ * Every sender increments a counter selected by the hash of its address,
+ * an object whose counter is zero is guaranteed not to be a sender.
+ */
+struct FFINHookSenderFilter {
+private:
+	static constexpr int32 SlotBits = 12;
+	std::atomic<uint16> Slots[1 << SlotBits] = {};
+
+	static int32 GetSlot(const UObject* Obj) {
+		return static_cast<int32>((static_cast<uint64>(reinterpret_cast<UPTRINT>(Obj)) * 0x9E3779B97F4A7C15ull) >> (64 - SlotBits));
+	}
+
+public:
+	void Add(const UObject* Obj) {
+		Slots[GetSlot(Obj)].fetch_add(1, std::memory_order_release);
+	}
+
+	void Remove(const UObject* Obj) {
+		std::atomic<uint16>& Slot = Slots[GetSlot(Obj)];
+		uint16 Count = Slot.load(std::memory_order_relaxed);
+		while (Count > 0 && !Slot.compare_exchange_weak(Count, Count - 1, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	/**
+	 * Returns false if the given object is for sure not in the filter
+	 */
+	bool MayContain(const UObject* Obj) const {
+		return Slots[GetSlot(Obj)].load(std::memory_order_acquire) > 0;
+	}
+};
+
 UCLASS()
 class FICSITNETWORKS_API UFINStaticReflectionHook : public UFINHook {
 	GENERATED_BODY()
@@ -60,8 +96,10 @@ protected:
 	UPROPERTY()
 	TSet<TWeakObjectPtr<UObject>> Senders;
 	FCriticalSection Mutex;
+	FFINHookSenderFilter SenderFilter;
 	
 	bool IsSender(UObject* Obj) {
+		if (!SenderFilter.MayContain(Obj)) return false;
 		FScopeLock Lock(&Mutex);
 		return Senders.Contains(Obj);
 	}
@@ -86,7 +124,9 @@ public:
 		Super::Register(sender);
 		
 		FScopeLock Lock(&Self()->Mutex);
-    	Self()->Senders.Add(Sender = sender);
+		bool bAlreadySender = false;
+    	Self()->Senders.Add(Sender = sender, &bAlreadySender);
+		if (!bAlreadySender) Self()->SenderFilter.Add(sender);
 
 		if (!Self()->bIsRegistered) {
 			Self()->bIsRegistered = true;
@@ -96,7 +136,7 @@ public:
 		
 	void Unregister() override {
 		FScopeLock Lock(&Self()->Mutex);
-    	Self()->Senders.Remove(Sender);
+    	if (Self()->Senders.Remove(Sender) > 0) Self()->SenderFilter.Remove(Sender);
     }
 };
 
@@ -117,8 +157,10 @@ protected:
 	UPROPERTY()
 	TSet<TWeakObjectPtr<UObject>> Senders;
 	FCriticalSection Mutex;
+	FFINHookSenderFilter SenderFilter;
 	
 	bool IsSender(UObject* Obj) {
+		if (!SenderFilter.MayContain(Obj)) return false;
 		FScopeLock Lock(&Mutex);
 		return Senders.Contains(Obj);
 	}
@@ -145,7 +187,9 @@ public:
 		Super::Register(sender);
 		
 		FScopeLock Lock(&Self()->Mutex);
-    	Self()->Senders.Add(Sender = sender);
+		bool bAlreadySender = false;
+    	Self()->Senders.Add(Sender = sender, &bAlreadySender);
+		if (!bAlreadySender) Self()->SenderFilter.Add(sender);
 
 		if (!Self()->bIsRegistered) {
 			Self()->bIsRegistered = true;
@@ -155,7 +199,7 @@ public:
 		
 	void Unregister() override {
 		FScopeLock Lock(&Self()->Mutex);
-    	Self()->Senders.Remove(Sender);
+    	if (Self()->Senders.Remove(Sender) > 0) Self()->SenderFilter.Remove(Sender);
     }
 };
 
@@ -389,26 +433,19 @@ protected:
 	// End UFINFunctionHook
 
 private:
-	static FCriticalSection MutexFactoryGrab;
-	static TMap<TWeakObjectPtr<UFGFactoryConnectionComponent>, int8> FactoryGrabsRunning;
+	// grabs nest within the same call stack, so the running grabs are tracked per thread and need no lock
+	static thread_local TArray<UFGFactoryConnectionComponent*, TInlineAllocator<4>> FactoryGrabsRunning;
 	
 	static void LockFactoryGrab(UFGFactoryConnectionComponent* comp) {
-		MutexFactoryGrab.Lock();
-		++FactoryGrabsRunning.FindOrAdd(comp);
-		MutexFactoryGrab.Unlock();
+		FactoryGrabsRunning.Push(comp);
 	}
 
+	/**
+	 * Returns true if the outermost grab of the given connector finished
+	 */
 	static bool UnlockFactoryGrab(UFGFactoryConnectionComponent* comp) {
-		MutexFactoryGrab.Lock();
-		int8* i = FactoryGrabsRunning.Find(comp);
-		bool valid = false;
-		if (i) {
-			--*i;
-			valid = (*i <= 0);
-			if (valid) FactoryGrabsRunning.Remove(comp);
-		}
-		MutexFactoryGrab.Unlock();
-		return valid;
+		FactoryGrabsRunning.Pop(false);
+		return !FactoryGrabsRunning.Contains(comp);
 	}
 
 	static void DoFactoryGrab(UFGFactoryConnectionComponent* c, FInventoryItem& item) {
@@ -489,7 +526,7 @@ private:
 		bool oldFused = circuit->IsFuseTriggered();
 		scope(circuit, dt);
 		bool fused = circuit->IsFuseTriggered();
-		if (oldFused != fused) try {
+		if (oldFused != fused && StaticSelf()->SenderFilter.MayContain(circuit)) try {
 			FScopeLock Lock(&StaticSelf()->Mutex);
 			TWeakObjectPtr<UObject>* sender = StaticSelf()->Senders.Find(circuit);
 			if (sender) {
@@ -3,6 +3,7 @@
 #include "FINBase.h"
 #include "FINFunction.h"
 #include "UObject/UObjectIterator.h"
+#include <atomic>
 #include "FINStruct.generated.h"
 
 UENUM()
@@ -14,6 +15,24 @@ enum EFINStructFlags {
 
 ENUM_CLASS_FLAGS(EFINStructFlags)
 
+/**
+ * Immutable flattened member tables of a struct including all inherited members.
+ * The name tables are sorted case-insensitively by name and refer to the index in the member arrays,
+ * members of the struct itself come before inherited members with the same name.
+ */
+struct FFINStructMemberTable {
+	struct FName2Index {
+		FString Name;
+		int32 Index;
+	};
+
+	uint32 Epoch = 0;
+	TArray<UFINProperty*> Properties;
+	TArray<UFINFunction*> Functions;
+	TArray<FName2Index> PropertyNames;
+	TArray<FName2Index> FunctionNames;
+};
+
 UCLASS(BlueprintType)
 class FICSITNETWORKS_API UFINStruct : public UFINBase {
 	GENERATED_BODY()
@@ -39,9 +58,8 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="Network|Reflection")
 	virtual TArray<UFINProperty*> GetProperties(bool bRecursive = true) const {
-		TArray<UFINProperty*> Props = Properties;
-		if (bRecursive && GetParent()) Props.Append(GetParent()->GetProperties());
-		return Props;
+		if (bRecursive) return GetMemberTable().Properties;
+		return Properties;
 	}
 	
 	/**
@@ -50,9 +68,19 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category="Network|Reflection")
 	virtual TArray<UFINFunction*> GetFunctions(bool bRecursive = true) const {
-		TArray<UFINFunction*> Funcs = Functions;
-		if (bRecursive && GetParent()) Funcs.Append(GetParent()->GetFunctions());
-		return Funcs;
+		if (bRecursive) return GetMemberTable().Functions;
+		return Functions;
+	}
+
+	/**
+	 * Returns the flattened member tables of this struct including all inherited members.
+	 * The tables get rebuilt if the reflection data changed since they got built,
+	 * otherwise this is lock-free and the returned tables are immutable.
+	 */
+	const FFINStructMemberTable& GetMemberTable() const {
+		const FFINStructMemberTable* Table = MemberTable.load(std::memory_order_acquire);
+		if (!Table || Table->Epoch != MemberTableEpoch.load(std::memory_order_acquire)) Table = BuildMemberTable();
+		return *Table;
 	}
 	
 	/**
@@ -98,15 +126,33 @@ public:
 	 */
 	UFINFunction* FindFINFunction(const FString& Name, EFINFunctionFlags FilterFlags = FIN_Func_MemberFunc);
 
+	/**
+	 * Marks the member tables of this struct and all structs extending from it as outdated,
+	 * so they get rebuilt on next access.
+	 * Has to get called whenever members or the parent of this struct change.
+	 */
 	UFUNCTION(BlueprintCallable)
 	virtual void InvalidateCache() {
-		FScopeLock nameCacheLock(&NameCacheMutex);
-		Name2Property.Empty();
-		Name2Function.Empty();
+		++MemberTableEpoch;
+		// children build their tables from ours, so without a table of ours there is nothing else to invalidate
+		if (!MemberTable.load(std::memory_order_acquire)) return;
+		for (TObjectIterator<UFINStruct> It; It; ++It) {
+			if (*It != this && It->IsChildOf(this)) ++It->MemberTableEpoch;
+		}
 	}
 
+	// Begin UObject
+	virtual void BeginDestroy() override;
+	// End UObject
+
 private:
-	FCriticalSection NameCacheMutex;
-	TMap<FString, TArray<UFINProperty*>> Name2Property;
-	TMap<FString, TArray<UFINFunction*>> Name2Function;
+	std::atomic<uint32> MemberTableEpoch = 0;
+	
+	mutable std::atomic<const FFINStructMemberTable*> MemberTable = nullptr;
+	// replaced tables stay alive until the struct gets destroyed, as other threads might still use them,
+	// they only pile up if the members of an already used struct change
+	mutable TArray<TUniquePtr<const FFINStructMemberTable>> RetiredMemberTables;
+	mutable FCriticalSection MemberTableMutex;
+
+	const FFINStructMemberTable* BuildMemberTable() const;
 };
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Fixed capacity ring buffer queue allowing multiple threads to push elements concurrently
+ * while exactly one thread consumes them.
+ * Push is lock-free, Pop is O(1) and does not need to shift any elements.
+ * Based on the sequence-per-cell design of Dmitry Vyukov's bounded queue.
+ *
+ * The limit can be any value, the underlying buffer gets rounded up to the next power of two.
+ */
+template<typename ElementType>
+class TFINBoundedMPSCQueue {
+	struct FCell {
+		std::atomic<uint64> Sequence;
+		TTypeCompatibleBytes<ElementType> Storage;
+	};
+
+	TUniquePtr<FCell[]> Cells;
+	uint64 Mask = 0;
+	uint64 Limit = 0;
+
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePos = 0;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Count = 0;
+
+public:
+	explicit TFINBoundedMPSCQueue(uint32 InLimit) {
+		Limit = FMath::Max<uint32>(InLimit, 1);
+		const uint64 Capacity = FMath::RoundUpToPowerOfTwo64(Limit);
+		Mask = Capacity - 1;
+		Cells = MakeUnique<FCell[]>(Capacity);
+		for (uint64 i = 0; i < Capacity; ++i) {
+			Cells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	~TFINBoundedMPSCQueue() {
+		Empty();
+	}
+
+	TFINBoundedMPSCQueue(const TFINBoundedMPSCQueue&) = delete;
+	TFINBoundedMPSCQueue& operator=(const TFINBoundedMPSCQueue&) = delete;
+
+	/**
+	 * Tries to push the given element to the end of the queue.
+	 * Can be called from any thread.
+	 *
+	 * @param[in]	InElement	the element you want to push
+	 * @return	false if the queue is full and the element got dropped
+	 */
+	template<typename ArgType>
+	bool Push(ArgType&& InElement) {
+		// reserve a slot first so the limit is exact and not bound to the power of two buffer size
+		uint64 Num = Count.load(std::memory_order_relaxed);
+		do {
+			if (Num >= Limit) return false;
+		} while (!Count.compare_exchange_weak(Num, Num + 1, std::memory_order_relaxed));
+
+		uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+		FCell* Cell;
+		while (true) {
+			Cell = &Cells[Pos & Mask];
+			const uint64 Seq = Cell->Sequence.load(std::memory_order_acquire);
+			const int64 Diff = static_cast<int64>(Seq) - static_cast<int64>(Pos);
+			if (Diff == 0) {
+				if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed)) break;
+			} else if (Diff < 0) {
+				// consumer has not released the cell yet, only possible for a very short time due to the reservation
+				FPlatformProcess::Yield();
+				Pos = EnqueuePos.load(std::memory_order_relaxed);
+			} else {
+				Pos = EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		new (&Cell->Storage) ElementType(Forward<ArgType>(InElement));
+		Cell->Sequence.store(Pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Pops the oldest element of the queue.
+	 * Must only be called by the single consumer.
+	 *
+	 * @param[out]	OutElement	the popped element
+	 * @return	false if no element was available
+	 */
+	bool Pop(ElementType& OutElement) {
+		const uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+		FCell& Cell = Cells[Pos & Mask];
+		const uint64 Seq = Cell.Sequence.load(std::memory_order_acquire);
+		if (Seq != Pos + 1) return false;
+		ElementType* Element = reinterpret_cast<ElementType*>(&Cell.Storage);
+		OutElement = MoveTemp(*Element);
+		Element->~ElementType();
+		DequeuePos.store(Pos + 1, std::memory_order_relaxed);
+		Cell.Sequence.store(Pos + Mask + 1, std::memory_order_release);
+		Count.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Pops up to the given amount of elements and appends them to the given array.
+	 * Must only be called by the single consumer.
+	 *
+	 * @param[out]	OutElements	array the popped elements get appended to
+	 * @param[in]	InMaxNum	the maximum amount of elements to pop
+	 * @return	the amount of popped elements
+	 */
+	int32 PopMany(TArray<ElementType>& OutElements, int32 InMaxNum) {
+		const int32 Available = FMath::Min<int64>(InMaxNum, Num());
+		if (Available <= 0) return 0;
+		OutElements.Reserve(OutElements.Num() + Available);
+		int32 Popped = 0;
+		ElementType Element;
+		while (Popped < InMaxNum && Pop(Element)) {
+			OutElements.Add(MoveTemp(Element));
+			++Popped;
+		}
+		return Popped;
+	}
+
+	/**
+	 * Removes all elements from the queue.
+	 * Must only be called by the single consumer.
+	 */
+	void Empty() {
+		uint64 Pos = DequeuePos.load(std::memory_order_relaxed);
+		while (true) {
+			FCell& Cell = Cells[Pos & Mask];
+			if (Cell.Sequence.load(std::memory_order_acquire) != Pos + 1) break;
+			reinterpret_cast<ElementType*>(&Cell.Storage)->~ElementType();
+			Cell.Sequence.store(Pos + Mask + 1, std::memory_order_release);
+			Count.fetch_sub(1, std::memory_order_release);
+			DequeuePos.store(++Pos, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Calls the given function for every element currently in the queue, oldest first.
+	 * Must only be called by the single consumer while no producer is pushing.
+	 */
+	template<typename FuncType>
+	void ForEach(FuncType&& InFunc) const {
+		const uint64 Begin = DequeuePos.load(std::memory_order_relaxed);
+		const uint64 End = EnqueuePos.load(std::memory_order_acquire);
+		for (uint64 Pos = Begin; Pos < End; ++Pos) {
+			const FCell& Cell = Cells[Pos & Mask];
+			if (Cell.Sequence.load(std::memory_order_acquire) != Pos + 1) break;
+			InFunc(*reinterpret_cast<const ElementType*>(&Cell.Storage));
+		}
+	}
+
+	/**
+	 * Returns the amount of elements in the queue.
+	 * Only a snapshot if producers are pushing concurrently.
+	 */
+	int64 Num() const {
+		return static_cast<int64>(Count.load(std::memory_order_acquire));
+	}
+
+	bool IsEmpty() const {
+		return Num() == 0;
+	}
+
+	uint32 GetLimit() const {
+		return static_cast<uint32>(Limit);
+	}
+};
@@ -0,0 +1,90 @@
+#include "FINLua/LuaChunkCache.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace FINLua {
+	FFINLuaChunkCache::FFINLuaChunkCache(int64 InMaxSize) : MaxSize(InMaxSize) {}
+
+	FFINLuaChunkCache& FFINLuaChunkCache::Get() {
+		static FFINLuaChunkCache Cache(32 * 1024 * 1024);
+		return Cache;
+	}
+
+	FSHAHash FFINLuaChunkCache::Hash(const char* InCode, size_t InSize, const char* InChunkName) {
+		// the chunk name is part of the compiled debug information
+		FSHA1 SHA;
+		SHA.Update(reinterpret_cast<const uint8*>(InChunkName), FCStringAnsi::Strlen(InChunkName) + 1);
+		SHA.Update(reinterpret_cast<const uint8*>(InCode), InSize);
+		SHA.Final();
+		FSHAHash Key;
+		SHA.GetHash(Key.Hash);
+		return Key;
+	}
+
+	bool FFINLuaChunkCache::Find(const FSHAHash& InKey, TArray<uint8>& OutBytecode) {
+		FScopeLock Lock(&Mutex);
+		FEntry* Entry = Entries.Find(InKey);
+		if (!Entry) return false;
+		Entry->LastUse = ++UseCounter;
+		OutBytecode = Entry->Bytecode;
+		return true;
+	}
+
+	void FFINLuaChunkCache::Add(const FSHAHash& InKey, TArray<uint8>&& InBytecode) {
+		const int64 ChunkSize = InBytecode.Num();
+		if (ChunkSize > MaxSize) return;
+		
+		FScopeLock Lock(&Mutex);
+		if (FEntry* Existing = Entries.Find(InKey)) {
+			Existing->LastUse = ++UseCounter;
+			return;
+		}
+		Evict(ChunkSize);
+		FEntry& Entry = Entries.Add(InKey);
+		Entry.Bytecode = MoveTemp(InBytecode);
+		Entry.LastUse = ++UseCounter;
+		Size += ChunkSize;
+	}
+
+	void FFINLuaChunkCache::Evict(int64 InRequiredSize) {
+		while (Size + InRequiredSize > MaxSize && Entries.Num() > 0) {
+			auto Oldest = Entries.CreateIterator();
+			for (auto It = Entries.CreateIterator(); It; ++It) {
+				if (It->Value.LastUse < Oldest->Value.LastUse) Oldest = It;
+			}
+			Size -= Oldest->Value.Bytecode.Num();
+			Oldest.RemoveCurrent();
+		}
+	}
+
+	void FFINLuaChunkCache::Empty() {
+		FScopeLock Lock(&Mutex);
+		Entries.Empty();
+		Size = 0;
+	}
+
+	int luaFIN_chunkWriter(lua_State* L, const void* Data, size_t Size, void* UserData) {
+		static_cast<TArray<uint8>*>(UserData)->Append(static_cast<const uint8*>(Data), Size);
+		return 0;
+	}
+
+	int luaFIN_loadBufferCached(lua_State* L, const char* InCode, size_t InSize, const char* InChunkName) {
+		ZoneScoped;
+		FFINLuaChunkCache& Cache = FFINLuaChunkCache::Get();
+		const FSHAHash Key = FFINLuaChunkCache::Hash(InCode, InSize, InChunkName);
+
+		TArray<uint8> Bytecode;
+		if (Cache.Find(Key, Bytecode)) {
+			const int Status = luaL_loadbufferx(L, reinterpret_cast<const char*>(Bytecode.GetData()), Bytecode.Num(), InChunkName, "b");
+			if (Status == LUA_OK) return Status;
+			lua_pop(L, 1);
+			Bytecode.Reset();
+		}
+
+		const int Status = luaL_loadbufferx(L, InCode, InSize, InChunkName, "t");
+		if (Status != LUA_OK) return Status;
+		lua_dump(L, luaFIN_chunkWriter, &Bytecode, 0);
+		Cache.Add(Key, MoveTemp(Bytecode));
+		return Status;
+	}
+}
@@ -47,10 +47,9 @@ namespace FINLua {
 		const int nameIndex = 2;
 		
 		FLuaClass* LuaClass = luaFIN_checkLuaClass(L, thisIndex);
-		FString MemberName = luaFIN_toFString(L, nameIndex);
 
 		FFINExecutionContext Context(LuaClass->UClass);
-		return luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaClass->FINClass, MemberName, FIN_Func_ClassFunc, FIN_Prop_ClassProp, Context, true);
+		return luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaClass->FINClass, nameIndex, FIN_Func_ClassFunc, FIN_Prop_ClassProp, Context, true);
 	}
 
 	int luaClassNewIndex(lua_State* L) {
@@ -210,8 +210,17 @@ namespace FINLua {
 		return 2;
 	} LuaFuncEnd()
 
+	int luaComputerStatistics(lua_State* L) {
+		const UFINLuaProcessor* Processor = UFINLuaProcessor::luaGetProcessor(L);
+		lua_pushnumber(L, Processor->GetScriptTime());
+		lua_pushnumber(L, Processor->GetGCTime());
+		lua_pushinteger(L, Processor->GetGCFullCollects());
+		return 3;
+	}
+
 	static const luaL_Reg luaComputerLib[] = {
 		{"getMemory", luaComputerMemory},
+		{"getStatistics", luaComputerStatistics},
 		{"getInstance", luaComputerGetInstance},
 		{"reset", luaComputerReset},
 		{"stop", luaComputerStop},
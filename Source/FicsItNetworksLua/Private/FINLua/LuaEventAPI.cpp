@@ -72,6 +72,14 @@ namespace FINLua {
 		return UFINLuaProcessor::luaAPIReturn(L, a);
 	}
 
+	int luaPullMany(lua_State* L) {
+		const lua_Integer MaxCount = luaL_optinteger(L, 1, UFINKernelNetworkController::MaxSignalCount);
+		UFINLuaProcessor* luaProc = UFINLuaProcessor::luaGetProcessor(L);
+		check(luaProc);
+		luaProc->DoSignals(L, static_cast<int>(FMath::Clamp<lua_Integer>(MaxCount, 0, UFINKernelNetworkController::MaxSignalCount)));
+		return UFINLuaProcessor::luaAPIReturn(L, 1);
+	}
+
 	void luaIgnore(lua_State* L, FFINNetworkTrace o) {
 		UObject* obj = *o;
 		if (!IsValid(obj)) luaL_error(L, "object is not valid");
@@ -121,6 +129,7 @@ namespace FINLua {
 		{"listen", luaListen},
 		{"listening", luaListening},
 		{"pull", luaPull},
+		{"pullMany", luaPullMany},
 		{"ignore", luaIgnore},
 		{"ignoreAll", luaIgnoreAll},
 		{"clear", luaClear},
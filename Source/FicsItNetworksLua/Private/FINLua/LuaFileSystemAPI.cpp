@@ -1,6 +1,7 @@
 #include "FINLua/LuaFileSystemAPI.h"
 
 #include "FINLuaProcessor.h"
+#include "FINLua/LuaChunkCache.h"
 
 #define LuaFunc(funcName) \
 int funcName(lua_State* L) { \
@@ -218,7 +219,7 @@ namespace FINLua {
 		try {
 			file->close();
 		} CatchExceptionLua
-		luaL_loadbufferx(L, code.c_str(), code.size(), ("@" + path.str()).c_str(), "t");
+		luaFIN_loadBufferCached(L, code.c_str(), code.size(), ("@" + path.str()).c_str());
 		lua_callk(L, 0, LUA_MULTRET, 0, luaDoFileCont);
 		return luaDoFileCont(L, 0, 0);
 	} LuaFuncEnd()
@@ -238,7 +239,7 @@ namespace FINLua {
 			file->close();
 		} CatchExceptionLua
 		
-		luaL_loadbufferx(L, code.c_str(), code.size(), ("@" + path.str()).c_str(), "t");
+		luaFIN_loadBufferCached(L, code.c_str(), code.size(), ("@" + path.str()).c_str());
 		return UFINLuaProcessor::luaAPIReturn(L, 1);
 	} LuaFuncEnd()
 	LuaFunc(path) {
@@ -360,7 +361,7 @@ namespace FINLua {
 			size_t str_len = 0;
 			const char* str = luaL_checklstring(L, i, &str_len);
 			try {
-				file->write(std::string(str, str_len));
+				file->write(str, str_len);
 			} CatchExceptionLua
 		}
 		return UFINLuaProcessor::luaAPIReturn(L, 0);
@@ -370,10 +371,24 @@ namespace FINLua {
 		const auto args = lua_gettop(L);
 		for (int i = 2; i <= args; ++i) {
 			try {
-				const auto n = lua_tointeger(L, i);
-				std::string s = file->read(n);
-				if (s.size() == 0 && file->isEOF()) lua_pushnil(L);
-				else lua_pushlstring(L, s.c_str(), s.size());
+				// reads in chunks straight into the lua string buffer, so huge counts only allocate what actually gets read
+				size_t remaining = static_cast<size_t>(lua_tointeger(L, i));
+				size_t length = 0;
+				luaL_Buffer buffer;
+				luaL_buffinit(L, &buffer);
+				while (remaining > 0) {
+					const size_t chunk = FMath::Min(remaining, CodersFileSystem::FileStream::BufferSize);
+					const size_t count = file->read(luaL_prepbuffsize(&buffer, chunk), chunk);
+					luaL_addsize(&buffer, count);
+					length += count;
+					remaining -= count;
+					if (count < chunk) break;
+				}
+				luaL_pushresult(&buffer);
+				if (length == 0 && file->isEOF()) {
+					lua_pop(L, 1);
+					lua_pushnil(L);
+				}
 			} catch (const std::exception& ex) {
 				luaL_error(L, ex.what());
 			}
@@ -5,20 +5,41 @@
 namespace FINLua {
 		typedef TSharedPtr<TFINDynamicStruct<FFINFuture>> LuaFuture;
 
+		int luaFuturePushOutput(lua_State* L, const LuaFuture& future) {
+			TArray<FFINAnyNetworkValue> Data = future->Get<FFINFuture>().GetOutput();
+			FFINNetworkTrace Trace;
+			if (future->GetStruct() == FFINFutureReflection::StaticStruct()) Trace = future->Get<FFINFutureReflection>().Context.GetTrace();
+			for (const FFINAnyNetworkValue& Param : Data) luaFIN_pushNetworkValue(L, Param, Trace);
+			return Data.Num();
+		}
+
+		/**
+		 * Suspends the processor until the kernel resolved its futures.
+		 * Has to get called right before yielding, so no error is able to leave the processor suspended.
+		 * Only allowed if all awaited futures are resolved on execution, everything else has to get polled.
+		 *
+		 * @param[in]	IsReady	checks if the awaited futures are ready
+		 * @return	false if the futures got ready before the wait got registered, so the caller must not yield
+		 */
+		bool luaFutureSuspend(lua_State* L, TFunctionRef<bool()> IsReady) {
+			FFINLuaProcessorTick& Tick = UFINLuaProcessor::luaGetProcessor(L)->GetTickHelper();
+			Tick.shouldWaitForFuture();
+			// the kernel might have resolved the futures before the wait got registered
+			if (!IsReady()) return true;
+			Tick.futureResolved();
+			return false;
+		}
+
 		int luaFutureAwaitContinue(lua_State* L, int, lua_KContext) {
 			LuaFuture& future = *static_cast<LuaFuture*>(luaL_checkudata(L, 1, "Future"));
-			if ((*future)->IsDone()) {
-				TArray<FFINAnyNetworkValue> Data = future->Get<FFINFuture>().GetOutput();
-				FFINNetworkTrace Trace;
-				if (future->GetStruct() == FFINFutureReflection::StaticStruct()) {
-					FScopeLock Lock(&future->Get<FFINFutureReflection>().Mutex);
-					Trace = future->Get<FFINFutureReflection>().Context.GetTrace();
+			if (!(*future)->IsDone()) {
+				// only the main thread suspends the processor, awaits within coroutines yield to the resuming code
+				const bool bSuspend = L == UFINLuaProcessor::luaGetProcessor(L)->GetLuaThread() && (*future)->IsResolvedOnExecute();
+				if (!bSuspend || luaFutureSuspend(L, [&future]() { return (*future)->IsDone(); })) {
+					return lua_yieldk(L, LUA_MULTRET, NULL, luaFutureAwaitContinue);
 				}
-				for (const FFINAnyNetworkValue& Param : Data) luaFIN_pushNetworkValue(L, Param, Trace);
-				return Data.Num();
-			} else {
-				return lua_yieldk(L, LUA_MULTRET, NULL, luaFutureAwaitContinue);
 			}
+			return luaFuturePushOutput(L, future);
 		}
 		
 		int luaFutureAwait(lua_State* L) {
@@ -42,6 +63,91 @@ namespace FINLua {
 		return 1;
 	}
 
+	LuaFuture& luaFutureCheckListEntry(lua_State* L, int Index) {
+		lua_geti(L, 1, Index);
+		LuaFuture* future = static_cast<LuaFuture*>(luaL_testudata(L, -1, "Future"));
+		if (!future) luaL_error(L, "entry %d of the future list is no future", Index);
+		lua_pop(L, 1);
+		return *future;
+	}
+
+	/**
+	 * Checks all entries of the future list and collects the futures that are not done yet.
+	 *
+	 * @param[out]	Pending	the futures of the list that are not done yet
+	 * @return	true if all pending futures are resolved by the kernel on execution, so the processor is allowed to suspend
+	 */
+	bool luaFutureCheckList(lua_State* L, lua_Integer Num, TArray<LuaFuture*>& Pending) {
+		bool bSuspend = true;
+		for (lua_Integer i = 1; i <= Num; ++i) {
+			LuaFuture& future = luaFutureCheckListEntry(L, i);
+			if ((*future)->IsDone()) continue;
+			Pending.Add(&future);
+			bSuspend = bSuspend && (*future)->IsResolvedOnExecute();
+		}
+		return bSuspend;
+	}
+
+	int luaFutureAllContinue(lua_State* L, int, lua_KContext) {
+		const lua_Integer Num = luaL_len(L, 1);
+		TArray<LuaFuture*> Pending;
+		const bool bSuspend = luaFutureCheckList(L, Num, Pending);
+		if (Pending.Num() > 0) {
+			auto IsReady = [&Pending]() {
+				for (LuaFuture* future : Pending) if (!(**future)->IsDone()) return false;
+				return true;
+			};
+			// yield without values, so it passes through coroutines and the whole runtime waits for the batch
+			if (!bSuspend || luaFutureSuspend(L, IsReady)) return lua_yieldk(L, 0, NULL, luaFutureAllContinue);
+		}
+
+		lua_createtable(L, Num, 0);
+		for (lua_Integer i = 1; i <= Num; ++i) {
+			const LuaFuture& future = luaFutureCheckListEntry(L, i);
+			lua_newtable(L);
+			const int Results = luaFuturePushOutput(L, future);
+			for (int j = Results; j > 0; --j) {
+				lua_seti(L, -j-1, j);
+			}
+			lua_seti(L, -2, i);
+		}
+		return UFINLuaProcessor::luaAPIReturn(L, 1);
+	}
+
+	int luaFutureAll(lua_State* L) {
+		luaL_checktype(L, 1, LUA_TTABLE);
+		lua_settop(L, 1);
+		return luaFutureAllContinue(L, 0, NULL);
+	}
+
+	int luaFutureRaceContinue(lua_State* L, int, lua_KContext) {
+		const lua_Integer Num = luaL_len(L, 1);
+		if (Num < 1) return UFINLuaProcessor::luaAPIReturn(L, 0);
+		TArray<LuaFuture*> Pending;
+		const bool bSuspend = luaFutureCheckList(L, Num, Pending);
+		if (Pending.Num() == Num) {
+			auto IsReady = [&Pending]() {
+				for (LuaFuture* future : Pending) if ((**future)->IsDone()) return true;
+				return false;
+			};
+			if (!bSuspend || luaFutureSuspend(L, IsReady)) return lua_yieldk(L, 0, NULL, luaFutureRaceContinue);
+		}
+		for (lua_Integer i = 1; i <= Num; ++i) {
+			const LuaFuture& future = luaFutureCheckListEntry(L, i);
+			if ((*future)->IsDone()) {
+				lua_pushinteger(L, i);
+				return UFINLuaProcessor::luaAPIReturn(L, luaFuturePushOutput(L, future) + 1);
+			}
+		}
+		return lua_yieldk(L, 0, NULL, luaFutureRaceContinue);
+	}
+
+	int luaFutureRace(lua_State* L) {
+		luaL_checktype(L, 1, LUA_TTABLE);
+		lua_settop(L, 1);
+		return luaFutureRaceContinue(L, 0, NULL);
+	}
+
 	int luaFutureNewIndex(lua_State* L) {
 		return 0;
 	}
@@ -89,6 +195,12 @@ namespace FINLua {
 		{nullptr, nullptr}
 	};
 
+	static const luaL_Reg luaFutureGlobalLib[] = {
+		{"all", luaFutureAll},
+		{"race", luaFutureRace},
+		{nullptr, nullptr}
+	};
+
 	static const luaL_Reg luaFutureMetaLib[] = {
 		{"__newindex", luaFutureNewIndex},
 		{"__gc", luaFutureGC},
@@ -119,5 +231,16 @@ namespace FINLua {
 		lua_pop(L, 1);
 		lua_pushcfunction(L, luaFutureUnpersist);
 		PersistValue("FutureUnpersist");
+
+		lua_newtable(L);
+		luaL_setfuncs(L, luaFutureGlobalLib, 0);
+		PersistTable("FutureGlobalLib", -1);
+		lua_setglobal(L, "future");
+		lua_pushcfunction(L, luaFutureAwaitContinue);
+		PersistValue("FutureAwaitContinue");
+		lua_pushcfunction(L, luaFutureAllContinue);
+		PersistValue("FutureAllContinue");
+		lua_pushcfunction(L, luaFutureRaceContinue);
+		PersistValue("FutureRaceContinue");
 	}
 }
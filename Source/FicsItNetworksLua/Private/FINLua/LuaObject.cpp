@@ -65,22 +65,26 @@ namespace FINLua {
 		const int nameIndex = 2;
 		
 		FLuaObject* LuaObject = luaFIN_checkLuaObject(L, thisIndex, nullptr);
-		FString MemberName = luaFIN_toFString(L, nameIndex);
 
-		UObject* NetworkHandler = UFINNetworkUtils::FindNetworkComponentFromObject(*LuaObject->Object);
-		if (NetworkHandler) {
-			if (MemberName == "id") {
-				lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetID(NetworkHandler).ToString()));
-				return 1;
-			}
-			if (MemberName == "nick") {
-				lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetNick(NetworkHandler)));
-				return 1;
+		// only look for the network component if the member is one of the network component members
+		if (lua_type(L, nameIndex) == LUA_TSTRING) {
+			const char* MemberName = lua_tostring(L, nameIndex);
+			const bool bID = FCStringAnsi::Strcmp(MemberName, "id") == 0;
+			if (bID || FCStringAnsi::Strcmp(MemberName, "nick") == 0) {
+				UObject* NetworkHandler = UFINNetworkUtils::FindNetworkComponentFromObject(*LuaObject->Object);
+				if (NetworkHandler) {
+					if (bID) {
+						lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetID(NetworkHandler).ToString()));
+					} else {
+						lua_pushstring(L, TCHAR_TO_UTF8(*IFINNetworkComponent::Execute_GetNick(NetworkHandler)));
+					}
+					return 1;
+				}
 			}
 		}
 
 		FFINExecutionContext Context(LuaObject->Object);
-		return luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaObject->Type, MemberName, FIN_Func_MemberFunc, FIN_Prop_Attrib, Context, true);
+		return luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaObject->Type, nameIndex, FIN_Func_MemberFunc, FIN_Prop_Attrib, Context, true);
 	}
 	
 	int luaObjectNewIndex(lua_State* L) {
@@ -11,23 +11,18 @@ namespace FINLua {
 	TArray<FINAny> luaFIN_callReflectionFunctionProcessInput(lua_State* L, UFINFunction* Function, int nArgs) {
 		int startArg = 2;
 		TArray<FINAny> Input;
-		TArray<UFINProperty*> Parameters = Function->GetParameters();
-		for (UFINProperty* Parameter : Parameters) {
-			if (Parameter->GetPropertyFlags() & FIN_Prop_Param && !(Parameter->GetPropertyFlags() & (FIN_Prop_OutParam | FIN_Prop_RetVal))) {
-				int index = lua_absindex(L, -nArgs);
-				TOptional<FINAny> Value = luaFIN_toNetworkValueByProp(L, index, Parameter, true, true);
-				if (Value.IsSet()) Input.Add(*Value);
-				else {
-					lua_gettop(L);
-					luaFIN_propertyError(L, Input.Num() + startArg, Parameter);
-				}
-				nArgs -= 1;
-				if (nArgs <= 0) break;
-			}
+		Input.Reserve(nArgs);
+		for (UFINProperty* Parameter : Function->GetCallLayout().InputParameters) {
+			if (nArgs <= 0) break;
+			int index = lua_absindex(L, -nArgs);
+			TOptional<FINAny> Value = luaFIN_toNetworkValueByProp(L, index, Parameter, true, true);
+			if (Value.IsSet()) Input.Add(MoveTemp(*Value));
+			else luaFIN_propertyError(L, Input.Num() + startArg, Parameter);
+			nArgs -= 1;
 		}
 		for (; nArgs > 0; nArgs -= 1) {
 			TOptional<FINAny> Value = luaFIN_toNetworkValue(L, lua_absindex(L, -nArgs));
-			if (Value.IsSet()) Input.Add(*Value);
+			if (Value.IsSet()) Input.Add(MoveTemp(*Value));
 			else Input.Add(FINAny());
 		}
 		return Input;
@@ -72,7 +67,7 @@ namespace FINLua {
 			return luaFIN_callReflectionFunctionDirectly(L, Function, Ctx, nArgs, nResults);
 		} else {
 			TArray<FINAny> Input = luaFIN_callReflectionFunctionProcessInput(L, Function, nArgs);
-			luaFuture(L, FFINFutureReflection(Function, Ctx, Input));
+			luaFuture(L, FFINFutureReflection(Function, Ctx, MoveTemp(Input)));
 			return 1;
 		}
 	}
@@ -156,38 +151,39 @@ namespace FINLua {
 		return *static_cast<UFINFunction**>(luaL_checkudata(L, Index, LUA_REFLECTION_FUNCTION_METATABLE_NAME));
 	}
 
-	int luaFIN_tryIndexGetProperty(lua_State* L, int Index, UFINStruct* Type, const FString& MemberName, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx) {
-		ZoneScoped;
-		UFINProperty* Property = Type->FindFINProperty(MemberName, PropertyFilterFlags);
-		if (Property) {
-			if (!PropertyCtx.IsValid()) {
-				return luaFIN_argError(L, Index, FString::Printf(TEXT("Reference to %s is invalid."), *luaFIN_typeName(L, Index)));
-			}
-			
-			EFINRepPropertyFlags PropFlags = Property->GetPropertyFlags();
-			// TODO: Add C++ try catch block to GetProperty Execution
-			if (PropFlags & FIN_Prop_RT_Async) {
+	int luaFIN_pushPropertyValue(lua_State* L, int Index, UFINProperty* Property, const FFINExecutionContext& PropertyCtx) {
+		if (!PropertyCtx.IsValid()) {
+			return luaFIN_argError(L, Index, FString::Printf(TEXT("Reference to %s is invalid."), *luaFIN_typeName(L, Index)));
+		}
+		
+		EFINRepPropertyFlags PropFlags = Property->GetPropertyFlags();
+		// TODO: Add C++ try catch block to GetProperty Execution
+		if (PropFlags & FIN_Prop_RT_Async) {
+			ZoneScopedN("Lua Get Property");
+			luaFIN_pushNetworkValue(L, Property->GetValue(PropertyCtx));
+		} else if (PropFlags & FIN_Prop_RT_Parallel) {
+			ZoneScopedN("Lua Get Property SyncCall");
+			[[maybe_unused]] FLuaSyncCall SyncCall(L);
+			{
 				ZoneScopedN("Lua Get Property");
 				luaFIN_pushNetworkValue(L, Property->GetValue(PropertyCtx));
-			} else if (PropFlags & FIN_Prop_RT_Parallel) {
-				ZoneScopedN("Lua Get Property SyncCall");
-				[[maybe_unused]] FLuaSyncCall SyncCall(L);
-				{
-					ZoneScopedN("Lua Get Property");
-					luaFIN_pushNetworkValue(L, Property->GetValue(PropertyCtx));
-				}
-			} else {
-				luaFuture(L, FFINFutureReflection(Property, PropertyCtx));
 			}
-			return 1;
+		} else {
+			luaFuture(L, FFINFutureReflection(Property, PropertyCtx));
 		}
+		return 1;
+	}
+
+	int luaFIN_tryIndexGetProperty(lua_State* L, int Index, UFINStruct* Type, const FString& MemberName, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx) {
+		ZoneScoped;
+		UFINProperty* Property = Type->FindFINProperty(MemberName, PropertyFilterFlags);
+		if (Property) return luaFIN_pushPropertyValue(L, Index, Property, PropertyCtx);
 		return 0;
 	}
 
 	int luaFIN_tryIndexFunction(lua_State* L, UFINStruct* Struct, const FString& MemberName, EFINFunctionFlags FunctionFilterFlags) {
 		UFINFunction* Function = Struct->FindFINFunction(MemberName, FunctionFilterFlags);
 		if (Function) {
-			// TODO: Add caching
 			luaFIN_pushReflectionFunction(L, Function);
 			return 1;
 		}
@@ -205,6 +201,77 @@ namespace FINLua {
 		return 1; // TODO: Remove return val and bCauseError param
 	}
 
+	/**
+	 * Pushes the member cache table of the given type and filter flags, creates it if it doesn't exist yet.
+	 * The cache maps the member name to the property as light userdata or to the reflection function userdata.
+	 * Only members found by their exact internal name get cached, so scripts can't grow the cache
+	 * beyond the members of the type by indexing with arbitrary names.
+	 */
+	void luaFIN_pushMemberCache(lua_State* L, UFINStruct* Struct, EFINFunctionFlags FunctionFilterFlags, EFINRepPropertyFlags PropertyFilterFlags) {
+		lua_getfield(L, LUA_REGISTRYINDEX, LUA_REF_CACHE);		// ..., RefCache
+		if (lua_rawgetp(L, -1, Struct) != LUA_TTABLE) {		// ..., RefCache, TypeCache
+			lua_pop(L, 1);										// ..., RefCache
+			lua_newtable(L);									// ..., RefCache, TypeCache
+			lua_pushvalue(L, -1);								// ..., RefCache, TypeCache, TypeCache
+			lua_rawsetp(L, -3, Struct);							// ..., RefCache, TypeCache
+		}
+		const lua_Integer FilterKey = (static_cast<lua_Integer>(FunctionFilterFlags) << 32) | static_cast<uint32>(PropertyFilterFlags);
+		if (lua_rawgeti(L, -1, FilterKey) != LUA_TTABLE) {		// ..., RefCache, TypeCache, MemberCache
+			lua_pop(L, 1);										// ..., RefCache, TypeCache
+			lua_newtable(L);									// ..., RefCache, TypeCache, MemberCache
+			lua_pushvalue(L, -1);								// ..., RefCache, TypeCache, MemberCache, MemberCache
+			lua_rawseti(L, -3, FilterKey);						// ..., RefCache, TypeCache, MemberCache
+		}
+		lua_replace(L, -3);										// ..., MemberCache, TypeCache
+		lua_pop(L, 1);											// ..., MemberCache
+	}
+
+	int luaFIN_pushFunctionOrGetProperty(lua_State* L, int Index, UFINStruct* Struct, int NameIndex, EFINFunctionFlags FunctionFilterFlags, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx, bool bCauseError) {
+		ZoneScoped;
+		NameIndex = lua_absindex(L, NameIndex);
+		if (lua_type(L, NameIndex) != LUA_TSTRING) {
+			return luaFIN_pushFunctionOrGetProperty(L, Index, Struct, luaFIN_toFString(L, NameIndex), FunctionFilterFlags, PropertyFilterFlags, PropertyCtx, bCauseError);
+		}
+
+		luaFIN_pushMemberCache(L, Struct, FunctionFilterFlags, PropertyFilterFlags);	// ..., MemberCache
+		lua_pushvalue(L, NameIndex);													// ..., MemberCache, Name
+		int MemberType = lua_rawget(L, -2);											// ..., MemberCache, Member
+		if (MemberType == LUA_TNIL) {
+			ZoneScopedN("Lua Member Cache Miss");
+			lua_pop(L, 1);																// ..., MemberCache
+			const FString MemberName = luaFIN_toFString(L, NameIndex);
+			UFINBase* Member = nullptr;
+			if (UFINProperty* Property = Struct->FindFINProperty(MemberName, PropertyFilterFlags)) {
+				Member = Property;
+				lua_pushlightuserdata(L, Property);									// ..., MemberCache, Member
+			} else if (UFINFunction* Function = Struct->FindFINFunction(MemberName, FunctionFilterFlags)) {
+				Member = Function;
+				luaFIN_pushReflectionFunction(L, Function);							// ..., MemberCache, Member
+			} else {
+				lua_pushnil(L);															// ..., MemberCache, nil
+			}
+			if (Member && Member->GetInternalName().Equals(MemberName, ESearchCase::CaseSensitive)) {
+				lua_pushvalue(L, NameIndex);											// ..., MemberCache, Member, Name
+				lua_pushvalue(L, -2);													// ..., MemberCache, Member, Name, Member
+				lua_rawset(L, -4);														// ..., MemberCache, Member
+			}
+			MemberType = lua_type(L, -1);
+		}
+		lua_remove(L, -2);																// ..., Member
+
+		if (MemberType == LUA_TLIGHTUSERDATA) {
+			UFINProperty* Property = static_cast<UFINProperty*>(lua_touserdata(L, -1));
+			lua_pop(L, 1);																// ...
+			return luaFIN_pushPropertyValue(L, Index, Property, PropertyCtx);
+		}
+		if (MemberType == LUA_TUSERDATA) return 1;
+		lua_pop(L, 1);																	// ...
+
+		if (bCauseError) luaFIN_warning(L, TCHAR_TO_UTF8(*("No property or function with name '" + luaFIN_toFString(L, NameIndex) + "' found. Nil return is deprecated and this will become an error.")), true);
+		lua_pushnil(L);
+		return 1;
+	}
+
 	bool luaFIN_tryExecuteSetProperty(lua_State* L, int Index, UFINStruct* Type, const FString& MemberName, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx, int ValueIndex, bool bCauseError) {
 		UFINProperty* Property = Type->FindFINProperty(MemberName, PropertyFilterFlags);
 		if (Property) {
@@ -238,6 +305,9 @@ namespace FINLua {
 	void setupRefUtils(lua_State* L) {
 		PersistSetup("ReflectionUtils", -2);
 
+		lua_newtable(L);													// ..., RefCache
+		lua_setfield(L, LUA_REGISTRYINDEX, LUA_REF_CACHE);				// ...
+
 		// Register & Persist ReflectionFunction-Metatable
 		luaL_newmetatable(L, LUA_REFLECTION_FUNCTION_METATABLE_NAME);		// ..., ReflectionFunctionMetatable
 		luaL_setfuncs(L, luaReflectionFunctionMetatable, 0);
@@ -259,10 +259,9 @@ namespace FINLua {
 		const int nameIndex = 2;
 		
 		FLuaStruct* LuaStruct = luaFIN_checkLuaStruct(L, thisIndex, nullptr);
-		FString MemberName = luaFIN_toFString(L, nameIndex);
 
 		FFINExecutionContext Context(LuaStruct->Struct->GetData());
-		int arg = luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaStruct->Type, MemberName, EFINFunctionFlags::FIN_Func_MemberFunc, EFINRepPropertyFlags::FIN_Prop_Attrib, Context, false);
+		int arg = luaFIN_pushFunctionOrGetProperty(L, thisIndex, LuaStruct->Type, nameIndex, EFINFunctionFlags::FIN_Func_MemberFunc, EFINRepPropertyFlags::FIN_Prop_Attrib, Context, false);
 		if (arg > 0) return arg;
 		return luaStructExecuteBinaryOperator(L, FIN_OP_TEXT(FIN_Operator_Index), 2, LuaStruct->Struct, LuaStruct->Type, nullptr);
 	}
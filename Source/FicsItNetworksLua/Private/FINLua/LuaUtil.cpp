@@ -139,7 +139,7 @@ namespace FINLua {
 			} else {
 				Trace = luaFIN_toObject(L, Index, nullptr);
 			}
-			if (Trace.IsSet()) return FINAny(Trace.GetValue());
+			if (Trace.IsSet()) return FINAny(MoveTemp(Trace.GetValue()));
 			return TOptional<FINAny>();
 		} case FIN_STRUCT: {
 			TSharedPtr<FINStruct> Struct;
@@ -165,10 +165,10 @@ namespace FINLua {
 				} else {
 					Value = luaFIN_toNetworkValue(L, -1);
 				}
-				if (Value.IsSet()) Array.Add(Value.GetValue());
+				if (Value.IsSet()) Array.Add(MoveTemp(Value.GetValue()));
 				lua_pop(L, 1);
 			}
-			return FINAny(Array);
+			return FINAny(MoveTemp(Array));
 		} case FIN_ANY: return luaFIN_toNetworkValue(L, Index);
 		default: ;
 		}
@@ -195,6 +195,8 @@ namespace FINLua {
 		case LUA_TSTRING:
 			return FINAny(luaFIN_toFinString(L, Index));
 		case LUA_TTABLE: {
+			// nested tables get passed as -1, which isn't the table anymore after pushing the key
+			Index = lua_absindex(L, Index);
 			FINArray Array;
 			lua_pushnil(L);
 			while (lua_next(L, Index) != 0) {
@@ -202,9 +204,9 @@ namespace FINLua {
 				TOptional<FINAny> Value = luaFIN_toNetworkValue(L, -1);
 				lua_pop(L, 1);
 				if (!Value.IsSet()) return TOptional<FINAny>();
-				Array.Add(*Value);
+				Array.Add(MoveTemp(*Value));
 			}
-			return FINAny(Array);
+			return FINAny(MoveTemp(Array));
 		} default:
 			TSharedPtr<FINStruct> Struct = luaFIN_toStruct(L, Index, nullptr, false);
 			if (Struct.IsValid()) return FINAny(static_cast<FINStruct>(*Struct));
@@ -0,0 +1,224 @@
+#include "FINLua/LuaUtil.h"
+
+#include "FINLuaProcessor.h"
+#include "FicsItKernel/FicsItKernel.h"
+#include "FINLua/LuaObject.h"
+#include "FINLua/LuaStruct.h"
+#include "Misc/AutomationTest.h"
+#include "Network/FINNetworkTrace.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+	/**
+	 * Bare lua state with only the struct and object system set up.
+	 * Pushed structs and objects register themselves at the kernel of the processor,
+	 * so a transient processor and kernel get registered like a real processor does.
+	 */
+	struct FFINLuaUtilTestState {
+		lua_State* L = nullptr;
+		UFINKernelSystem* Kernel = nullptr;
+		UFINLuaProcessor* Processor = nullptr;
+
+		FFINLuaUtilTestState() {
+			Kernel = NewObject<UFINKernelSystem>();
+			Kernel->AddToRoot();
+			Processor = NewObject<UFINLuaProcessor>();
+			Processor->AddToRoot();
+			Processor->SetKernel(Kernel);
+
+			L = luaL_newstate();
+			lua_newtable(L); // perm
+			lua_newtable(L); // perm, uperm
+			luaL_newmetatable(L, "LuaProcessor"); // perm, uperm, mt-LuaProcessor
+			lua_pop(L, 1); // perm, uperm
+			*static_cast<UFINLuaProcessor**>(lua_newuserdata(L, sizeof(UFINLuaProcessor*))) = Processor; // perm, uperm, proc
+			luaL_setmetatable(L, "LuaProcessor");
+			lua_setfield(L, LUA_REGISTRYINDEX, "LuaProcessorPtr"); // perm, uperm
+			FINLua::setupStructSystem(L);
+			FINLua::setupObjectSystem(L);
+			lua_pop(L, 2);
+		}
+
+		~FFINLuaUtilTestState() {
+			// closing the state runs the finalizers of the pushed values, they still need the kernel
+			lua_close(L);
+			Processor->RemoveFromRoot();
+			Kernel->RemoveFromRoot();
+		}
+
+		TOptional<FINAny> RoundTrip(const FINAny& Value) {
+			FINLua::luaFIN_pushNetworkValue(L, Value);
+			TOptional<FINAny> Result = FINLua::luaFIN_toNetworkValue(L, -1);
+			lua_pop(L, 1);
+			return Result;
+		}
+	};
+
+	bool NetworkValuesEqual(const FINAny& A, const FINAny& B) {
+		if (A.GetType() != B.GetType()) return false;
+		switch (A.GetType()) {
+		case FIN_NIL:
+			return true;
+		case FIN_BOOL:
+			return A.GetBool() == B.GetBool();
+		case FIN_INT:
+			return A.GetInt() == B.GetInt();
+		case FIN_FLOAT:
+			return A.GetFloat() == B.GetFloat();
+		case FIN_STR:
+			return A.GetString() == B.GetString();
+		case FIN_OBJ:
+			return A.GetObj() == B.GetObj();
+		case FIN_CLASS:
+			return A.GetClass() == B.GetClass();
+		case FIN_TRACE:
+			return A.GetTrace() == B.GetTrace();
+		case FIN_STRUCT: {
+			const FINStruct& StructA = A.GetStruct();
+			const FINStruct& StructB = B.GetStruct();
+			return StructA.GetStruct() == StructB.GetStruct() && StructA.GetStruct()->CompareScriptStruct(StructA.GetData(), StructB.GetData(), 0);
+		} case FIN_ARRAY: {
+			const FINArray& ArrayA = A.GetArray();
+			const FINArray& ArrayB = B.GetArray();
+			if (ArrayA.Num() != ArrayB.Num()) return false;
+			for (int32 i = 0; i < ArrayA.Num(); ++i) {
+				if (!NetworkValuesEqual(ArrayA[i], ArrayB[i])) return false;
+			}
+			return true;
+		} case FIN_ANY:
+			return NetworkValuesEqual(A.GetAny(), B.GetAny());
+		default:
+			return false;
+		}
+	}
+
+	FINArray MakeTestArray(int32 Num) {
+		FINArray Array;
+		for (int32 i = 0; i < Num; ++i) {
+			switch (i % 3) {
+			case 0:
+				Array.Add(FINAny(static_cast<FINInt>(i)));
+				break;
+			case 1:
+				Array.Add(FINAny(FString::Printf(TEXT("Entry %i"), i)));
+				break;
+			default:
+				Array.Add(FINAny(FINArray{FINAny(static_cast<FINFloat>(i) * 0.5), FINAny(true)}));
+			}
+		}
+		return Array;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINLuaUtilNetworkValueTest, "FicsItNetworks.Lua.Util.NetworkValue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFINLuaUtilNetworkValueTest::RunTest(const FString& Parameters) {
+	FFINLuaUtilTestState State;
+	UObject* Object = NewObject<UObject>();
+
+	const FINAny String(FString(TEXT("Hello, \u00E4\u00F6\u00FC World!")));
+	const FINAny Array(MakeTestArray(20));
+	const FINAny Struct(FINStruct(FVector(1.0, -2.5, 3.25)));
+	const FINAny Trace{FINTrace(Object)};
+
+	// round trip through lua
+	const int Top = lua_gettop(State.L);
+	TOptional<FINAny> Result = State.RoundTrip(String);
+	TestTrue(TEXT("String survives the round trip"), Result.IsSet() && NetworkValuesEqual(*Result, String));
+	Result = State.RoundTrip(Array);
+	TestTrue(TEXT("Nested array survives the round trip"), Result.IsSet() && NetworkValuesEqual(*Result, Array));
+	Result = State.RoundTrip(FINAny(FINArray()));
+	TestTrue(TEXT("Empty array survives the round trip"), Result.IsSet() && Result->GetType() == FIN_ARRAY && Result->GetArray().Num() == 0);
+	Result = State.RoundTrip(Struct);
+	TestTrue(TEXT("Struct survives the round trip"), Result.IsSet() && NetworkValuesEqual(*Result, Struct));
+	// lua only keeps the trace inside the object reference, reading it back without property info yields the plain object
+	Result = State.RoundTrip(Trace);
+	TestTrue(TEXT("Trace survives the round trip as its object"), Result.IsSet() && Result->GetType() == FIN_OBJ && Result->GetObj().Get() == Object);
+	TestEqual(TEXT("Round trips leave the lua stack balanced"), lua_gettop(State.L), Top);
+
+	// copies share the immutable payloads
+	const FINAny ArrayCopy = Array;
+	TestTrue(TEXT("Array copy shares the payload"), &ArrayCopy.GetArray() == &Array.GetArray());
+	TestTrue(TEXT("Array copy compares equal"), NetworkValuesEqual(ArrayCopy, Array));
+	const FINAny StructCopy = Struct;
+	TestTrue(TEXT("Struct copy shares the payload"), &StructCopy.GetStruct() == &Struct.GetStruct());
+	TestTrue(TEXT("Struct copy compares equal"), NetworkValuesEqual(StructCopy, Struct));
+	FINAny TraceCopy;
+	TraceCopy = Trace;
+	TestTrue(TEXT("Trace copy compares equal"), NetworkValuesEqual(TraceCopy, Trace));
+	TestTrue(TEXT("Trace copy points to the object"), TraceCopy.GetTrace().Get() == Object);
+
+	// moved from values become nil
+	const FINAny* Values[] = {&String, &Array, &Struct, &Trace};
+	for (const FINAny* Value : Values) {
+		FINAny Source = *Value;
+		FINAny Moved(MoveTemp(Source));
+		TestTrue(TEXT("Move construction leaves the source nil"), Source.GetType() == FIN_NIL);
+		TestTrue(TEXT("Move construction keeps the value"), NetworkValuesEqual(Moved, *Value));
+
+		FINAny Assigned(static_cast<FINInt>(42));
+		Assigned = MoveTemp(Moved);
+		TestTrue(TEXT("Move assignment leaves the source nil"), Moved.GetType() == FIN_NIL);
+		TestTrue(TEXT("Move assignment keeps the value"), NetworkValuesEqual(Assigned, *Value));
+
+		const FINAny& Self = Assigned;
+		Assigned = Self;
+		TestTrue(TEXT("Self assignment keeps the value"), NetworkValuesEqual(Assigned, *Value));
+	}
+
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINLuaUtilNetworkValueBenchmark, "FicsItNetworks.Lua.Util.NetworkValueBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFINLuaUtilNetworkValueBenchmark::RunTest(const FString& Parameters) {
+	constexpr int32 Iterations = 10000;
+	constexpr int32 ArraySize = 100;
+
+	FFINLuaUtilTestState State;
+	UObject* Object = NewObject<UObject>();
+
+	auto Measure = [](TFunctionRef<void()> Func) {
+		const uint64 Start = FPlatformTime::Cycles64();
+		Func();
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Start);
+	};
+	int32 Failed = 0;
+	auto RoundTrips = [&](const TCHAR* Name, const FINAny& Value) {
+		const double Time = Measure([&]() {
+			for (int32 i = 0; i < Iterations; ++i) Failed += !State.RoundTrip(Value).IsSet();
+			// let the finalizers of the pushed structs and objects run as part of the measurement
+			lua_gc(State.L, LUA_GCCOLLECT, 0);
+		});
+		AddInfo(FString::Printf(TEXT("%s: %.3fms for %i round trips (%.3fus each)"), Name, Time, Iterations, Time * 1000.0 / Iterations));
+	};
+
+	RoundTrips(TEXT("String"), FINAny(FString(TEXT("Some string a program might send around"))));
+	RoundTrips(TEXT("Array"), FINAny(MakeTestArray(ArraySize)));
+	RoundTrips(TEXT("Struct"), FINAny(FINStruct(FVector(1.0, 2.0, 3.0))));
+	RoundTrips(TEXT("Trace"), FINAny(FINTrace(Object)));
+	TestEqual(TEXT("All round trips converted back"), Failed, 0);
+
+	// copying a value shares the payload, copying the array itself has to copy every entry
+	const FINAny Array(MakeTestArray(ArraySize));
+	int64 Entries = 0;
+	const double SharedTime = Measure([&]() {
+		for (int32 i = 0; i < Iterations; ++i) {
+			const FINAny Copy = Array;
+			Entries += Copy.GetArray().Num();
+		}
+	});
+	const double DeepTime = Measure([&]() {
+		for (int32 i = 0; i < Iterations; ++i) {
+			const FINArray Copy = Array.GetArray();
+			Entries -= Copy.Num();
+		}
+	});
+	AddInfo(FString::Printf(TEXT("Array copy: shared %.3fms, deep %.3fms (x%.1f)"), SharedTime, DeepTime, DeepTime / FMath::Max(SharedTime, UE_DOUBLE_SMALL_NUMBER)));
+	TestEqual(TEXT("Shared and deep copies have the same entries"), Entries, static_cast<int64>(0));
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include "FicsItNetworksLuaModule.h"
 #include "FicsItKernel/Logging.h"
 #include "FINStateEEPROMLua.h"
+#include "FINLua/LuaChunkCache.h"
 #include "FINLua/LuaGlobalLib.h"
 #include "FINLua/LuaObject.h"
 #include "Network/FINNetworkTrace.h"
@@ -28,66 +29,53 @@ void LuaFileSystemListener::onNodeRemoved(CodersFileSystem::Path path, CodersFil
 	}
 }
 
-// ReSharper disable once CppMemberFunctionMayBeConst
-void FLuaTickRunnable::DoWork() {
-	while (true) {
-		if (!Tick->asyncTick()) {
-			break;
-		}
-	}
-}
-
-FFINLuaProcessorTick::FFINLuaProcessorTick() : Runnable(this) {}
+FFINLuaProcessorTick::FFINLuaProcessorTick() {}
 
-FFINLuaProcessorTick::FFINLuaProcessorTick(UFINLuaProcessor* Processor): Processor(Processor), Runnable(this) {
+FFINLuaProcessorTick::FFINLuaProcessorTick(UFINLuaProcessor* Processor): Processor(Processor) {
 	reset();
 }
 
 FFINLuaProcessorTick::~FFINLuaProcessorTick() {
 	stop();
-	if (asyncTask) asyncTask->EnsureCompletion();
+	if (IsScheduled()) FFINLuaScheduler::Get().Cancel(this);
+}
+
+bool FFINLuaProcessorTick::RunSlice() {
+	return asyncTick();
+}
+
+void FFINLuaProcessorTick::OnSyncBegin() {
+	// async tick is waiting for sync, continue it in sync with the game and run sync afterwards
+	shouldDemote();
+	State = LUA_SYNC;
 }
 
 void FFINLuaProcessorTick::reset() {
 	stop();
 
-	AsyncSync = TPromise<void>();
-	SyncAsync = TPromise<void>();
-	AsyncSync.EmplaceValue();
-	SyncAsync.EmplaceValue();
 	bShouldPromote = false;
 	bShouldDemote = false;
 	bShouldStop = false;
 	bShouldReset = false;
 	bShouldCrash = false;
-	bDoSync = false;
+	bWaitForFuture = false;
 	State = LUA_SYNC;
 }
 
 void FFINLuaProcessorTick::stop() {
 	if (!(State & LUA_ASYNC)) return;
 	demote();
-	
-	if (asyncTask.IsValid() && !asyncTask->IsIdle()) {
-		asyncTask->EnsureCompletion();
-		asyncTask->Cancel();
-		asyncTask.Reset();
-	}
 }
 
 void FFINLuaProcessorTick::promote() {
 	if (State & LUA_ASYNC) return;
 	if (bShouldStop || bShouldCrash || bShouldReset) return;
-	if (asyncTask.IsValid()) {
-		if (!asyncTask->IsDone()) asyncTask->EnsureCompletion();
-		asyncTask->Cancel();
-		asyncTask = nullptr;
-	}
-	asyncTask = MakeShared<FAsyncTask<FLuaTickRunnable>>(this);
+	FFINLuaScheduler& Scheduler = FFINLuaScheduler::Get();
+	if (IsScheduled()) Scheduler.Cancel(this);
 	TickMutex.Lock();
-	asyncTask->StartBackgroundTask();
 	State = LUA_ASYNC;
 	TickMutex.Unlock();
+	Scheduler.Schedule(this);
 }
 
 void FFINLuaProcessorTick::demote() {
@@ -98,25 +86,15 @@ void FFINLuaProcessorTick::demote() {
 	}
 	State = LUA_SYNC;
 	TickMutex.Unlock();
-	if (bDoSync) {
-		SyncAsync = TPromise<void>();
-		AsyncSync.EmplaceValue();
-	}
-	asyncTask->EnsureCompletion();
-	asyncTask->Cancel();
-	TickMutex.Unlock();
+	FFINLuaScheduler::Get().Cancel(this);
 }
 
 void FFINLuaProcessorTick::demoteInAsync() {
 	if (State & LUA_SYNC) return;
-	AsyncSyncMutex.Lock();
-	AsyncSync = TPromise<void>();
-	SyncAsync = TPromise<void>();
-	const TFuture<void> Future = AsyncSync.GetFuture();
-	bDoSync = true;
-	AsyncSyncMutex.Unlock();
 	TickMutex.Unlock();
-	Future.Wait(); // wait for sync to continue this async
+	const uint64 WaitStart = FPlatformTime::Cycles64();
+	FFINLuaScheduler::Get().WaitForSync(this); // wait for sync join to continue this async tick
+	SyncWaitCycles += FPlatformTime::Cycles64() - WaitStart;
 	TickMutex.Lock();
 }
 
@@ -147,6 +125,18 @@ void FFINLuaProcessorTick::signalFound() {
 	bWaitForSignal = false;
 }
 
+void FFINLuaProcessorTick::shouldWaitForFuture() {
+	bWaitForFuture = true;
+}
+
+void FFINLuaProcessorTick::futureResolved() {
+	if (!bWaitForFuture.exchange(false)) return;
+	// wake the async tick directly instead of waiting for the next factory tick
+	if ((State & LUA_ASYNC) && !bWaitForSignal && !IsScheduled()) {
+		FFINLuaScheduler::Get().Schedule(this);
+	}
+}
+
 void FFINLuaProcessorTick::shouldCrash(const TSharedRef<FFINKernelCrash>& Crash) {
 	bShouldCrash = true;
 	ToCrash = Crash;
@@ -155,45 +145,25 @@ void FFINLuaProcessorTick::shouldCrash(const TSharedRef<FFINKernelCrash>& Crash)
 void FFINLuaProcessorTick::syncTick() {
 	if (postTick()) return;
 	if (State & LUA_SYNC) {
-		if (asyncTask.IsValid() && !asyncTask->IsIdle()) {
-			asyncTask->EnsureCompletion();
-			asyncTask->Cancel();
-			asyncTask.Reset();
-		}
-		TickMutex.Lock();
-		{
-			ZoneScoped;
-			Processor->LuaTick();
+		// the last async slice might still be finishing after it demoted itself
+		if (IsScheduled()) FFINLuaScheduler::Get().Cancel(this);
+		// awaiting a future, gets continued once the kernel resolved it
+		if (!bWaitForFuture) {
+			TickMutex.Lock();
+			{
+				ZoneScoped;
+				Processor->LuaTick();
+			}
+			TickMutex.Unlock();
 		}
-		TickMutex.Unlock();
 		if (bShouldPromote) {
 			promote();
 		}
 	} else if (State & LUA_ASYNC) {
-		AsyncSyncMutex.Lock();
-		const bool DoSync = bDoSync;
-		const bool WaitForSignal = bWaitForSignal;
-		AsyncSyncMutex.Unlock();
-		if (DoSync) {
-			// async tick is waiting for sync
-			AsyncSyncMutex.Lock();
-			SyncAsync = TPromise<void>();
-			const TFuture<void> Future = SyncAsync.GetFuture();
-			shouldDemote();
-			State = LUA_SYNC;
-			AsyncSync.EmplaceValue(); // continue async tick in sync with factory tick
-			AsyncSyncMutex.Unlock();
-			Future.Wait(); // wait for async tick to finish
-			AsyncSyncMutex.Lock();
-			bDoSync = false;
-			AsyncSyncMutex.Unlock();
-		} else {
-			if (asyncTask->IsDone() && (!WaitForSignal || Processor->GetKernel()->GetNetwork()->GetSignalCount() > 0 || Processor->PullTimeoutReached())) {
-				AsyncSyncMutex.Lock();
-				bWaitForSignal = false;
-				AsyncSyncMutex.Unlock();
-				asyncTask->StartBackgroundTask();
-			}
+		// waiting for sync gets handled by the sync join of the scheduler
+		if (!IsScheduled() && !bWaitForFuture && (!bWaitForSignal || Processor->GetKernel()->GetNetwork()->GetSignalCount() > 0 || Processor->PullTimeoutReached())) {
+			bWaitForSignal = false;
+			FFINLuaScheduler::Get().Schedule(this);
 		}
 	}
 	if (postTick()) return;
@@ -207,12 +177,6 @@ bool FFINLuaProcessorTick::asyncTick() {
 			Processor->LuaTick();
 		}
 		TickMutex.Unlock();
-		AsyncSyncMutex.Lock();
-		if (bDoSync) {
-			SyncAsync.EmplaceValue();
-			bDoSync = false;
-		}
-		AsyncSyncMutex.Unlock();
 		if (bShouldDemote) {
 			TickMutex.Lock();
 			State = LUA_SYNC;
@@ -226,7 +190,7 @@ bool FFINLuaProcessorTick::asyncTick() {
 			TickMutex.Unlock();
 			return false;
 		}
-		return !bWaitForSignal;
+		return !bWaitForSignal && !bWaitForFuture;
 	}
 	return false;
 }
@@ -286,22 +250,47 @@ int FFINLuaProcessorTick::steps() const {
 	case LUA_SYNC:
 		return SyncLen;
 	case LUA_SYNC_ERROR:
-		return SyncErrorLen;
+		return SyncLen / 2;
 	case LUA_SYNC_END:
-		return SyncEndLen;
+		return SyncLen / 5;
 	case LUA_ASYNC_BEGIN:
 		return AsyncLen;
 	case LUA_ASYNC:
 		return AsyncLen;
 	case LUA_ASYNC_ERROR:
-		return AsyncErrorLen;
+		return AsyncLen / 2;
 	case LUA_ASYNC_END:
-		return AsyncEndLen;
+		return AsyncLen / 5;
 	default:
 		return LUA_SYNC;
 	}
 }
 
+void FFINLuaProcessorTick::stepsExhausted() {
+	bStepsExhausted = true;
+}
+
+void FFINLuaProcessorTick::updateSteps(uint64 InTickCycles, bool bInSync) {
+	// only ticks running out of steps tell how long the given amount of instructions took
+	if (!bStepsExhausted) return;
+	bStepsExhausted = false;
+	
+	int& Len = bInSync ? SyncLen : AsyncLen;
+	double& StepCost = bInSync ? SyncStepCost : AsyncStepCost;
+	const double Cost = FPlatformTime::ToSeconds64(InTickCycles) / Len;
+	StepCost = StepCost > 0.0 ? FMath::Lerp(StepCost, Cost, 0.2) : Cost;
+	
+	// sync ticks share the frame budget of all computers
+	const double Target = bInSync ? SyncSliceTarget * FFINLuaScheduler::Get().GetSyncBudgetScale() : AsyncSliceTarget;
+	Len = FMath::Clamp(static_cast<int>(Target / FMath::Max(StepCost, UE_DOUBLE_SMALL_NUMBER)), MinSteps, MaxSteps);
+}
+
+uint64 FFINLuaProcessorTick::consumeSyncWaitCycles() {
+	const uint64 Cycles = SyncWaitCycles;
+	SyncWaitCycles = 0;
+	return Cycles;
+}
+
 UFINLuaProcessor* UFINLuaProcessor::luaGetProcessor(lua_State* L) {
 	lua_getfield(L, LUA_REGISTRYINDEX, "LuaProcessorPtr");
 	UFINLuaProcessor* p = *static_cast<UFINLuaProcessor**>(luaL_checkudata(L, -1, "LuaProcessor"));
@@ -387,15 +376,18 @@ void UFINLuaProcessor::PreSaveGame_Implementation(int32 saveVersion, int32 gameV
 
 		lua_pushcfunction(luaState, luaPersist);					// ..., perm, globals, perm, data, persist-func
 		lua_insert(luaState, -3);									// ..., perm, globals, persist-func, perm, data
+		const double PersistStart = FPlatformTime::Seconds();
 		const int status = lua_pcall(luaState, 2, 1, 0);			// ..., perm, globals, data-str
 
 		// check unpersist
 		if (status == LUA_OK) {
-			// encode persisted data
+			// compress persisted data
+			const double CompressStart = FPlatformTime::Seconds();
 			size_t data_l = 0;
 			const char* data_r = lua_tolstring(luaState, -1, &data_l);
-			TArray<uint8> data((uint8*)data_r, data_l);
-			StateStorage.LuaData = FBase64::Encode(data);
+			StateStorage.SetLuaData(reinterpret_cast<const uint8*>(data_r), data_l);
+			const double End = FPlatformTime::Seconds();
+			UE_LOG(LogFicsItNetworksLua, Display, TEXT("%s: Lua Processor persisted %llu bytes to %lld stored bytes (persist %.2fms, compress %.2fms)"), *DebugInfo, static_cast<uint64>(data_l), StateStorage.GetLuaDataStoredSize(), (CompressStart - PersistStart) * 1000.0, (End - CompressStart) * 1000.0);
 	
 			lua_pop(luaState, 1); // ..., perm, globals
 		} else {
@@ -452,10 +444,11 @@ void UFINLuaProcessor::PostLoadGame_Implementation(int32 saveVersion, int32 game
 
 	Reset();
 
-	// decode & check data from json
+	// decompress & check data
+	const double DecompressStart = FPlatformTime::Seconds();
 	TArray<uint8> data;
-	FBase64::Decode(StateStorage.LuaData, data);
-	if (data.Num() <= 1) return;
+	if (!StateStorage.GetLuaData(data)) return;
+	const double UnpersistStart = FPlatformTime::Seconds();
 
 	// get uperm table
 	lua_getfield(luaState, LUA_REGISTRYINDEX, "PersistUperm");			// ..., uperm
@@ -497,6 +490,9 @@ void UFINLuaProcessor::PostLoadGame_Implementation(int32 saveVersion, int32 game
 		lua_seti(luaState, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS); // ..., uperm, data
 		luaThread = lua_tothread(luaState, luaThreadIndex);
 		lua_pop(luaState, 2); // ...
+
+		const double End = FPlatformTime::Seconds();
+		UE_LOG(LogFicsItNetworksLua, Display, TEXT("%s: Lua Processor unpersisted %i bytes from %lld stored bytes (decompress %.2fms, unpersist %.2fms)"), *DebugInfo, data.Num(), StateStorage.GetLuaDataStoredSize(), (UnpersistStart - DecompressStart) * 1000.0, (End - UnpersistStart) * 1000.0);
 	}
 }
 
@@ -532,20 +528,21 @@ void UFINLuaProcessor::LuaTick() {
 		
 		int nres = -1;
 		int Status;
+		const bool bSyncTick = static_cast<bool>(tickHelper.getState() & LUA_SYNC);
+		const uint64 ScriptStart = FPlatformTime::Cycles64();
 		if (PullState != 0) {
 			// Runtime is pulling a signal
 			if (GetKernel() && GetKernel()->GetNetwork() && GetKernel()->GetNetwork()->GetSignalCount() > 0) {
-				// Signal available -> reset timeout and pull signal from network
-				PullState = 0;
-				GetTickHelper().signalFound();
+				// Signal available -> pull signal from network
 				const int SigArgCount = DoSignal(luaThread);
 				if (SigArgCount < 1) {
-					// no signals popped -> crash system
-					Status = LUA_ERRRUN;
-				} else {
-					// signal popped -> resume yield with signal as parameters (passing signals parameters back to pull yield)
-					Status = lua_resume(luaThread, luaState, SigArgCount, &nres);
+					// signal is still being pushed by another thread -> skip tick
+					return;
 				}
+				// signal popped -> reset timeout and resume yield with signal as parameters (passing signals parameters back to pull yield)
+				PullState = 0;
+				GetTickHelper().signalFound();
+				Status = lua_resume(luaThread, luaState, SigArgCount, &nres);
 			} else if (PullState == 2 || !PullTimeoutReached()) {
 				// no signal available & not timeout reached -> skip tick
 				return;
@@ -559,11 +556,21 @@ void UFINLuaProcessor::LuaTick() {
 			// resume runtime normally
 			Status = lua_resume(luaThread, luaState, 0, &nres);
 		}
+		// time spent blocked on the sync join of sync calls doesn't count as script time
+		const uint64 TickScriptCycles = FPlatformTime::Cycles64() - ScriptStart - tickHelper.consumeSyncWaitCycles();
+		ScriptCycles += TickScriptCycles;
+		tickHelper.updateSteps(TickScriptCycles, bSyncTick);
+		if (bSyncTick) FFINLuaScheduler::Get().AddSyncCycles(TickScriptCycles);
 		if (Status == LUA_YIELD) {
 			// system yielded and waits for next tick
-			lua_gc(luaState, LUA_GCCOLLECT, 0);
+			CollectGarbage(TickScriptCycles);
 			if (GetKernel()) {
 				TSharedPtr<FFINKernelCrash> Crash = GetKernel()->RecalculateResources(UFINKernelSystem::PROCESSOR);
+				if (Crash) {
+					// usage might still contain garbage the incremental steps didn't get to yet
+					CollectAllGarbage();
+					Crash = GetKernel()->RecalculateResources(UFINKernelSystem::PROCESSOR);
+				}
 				if (Crash) {
 					tickHelper.shouldCrash(Crash.ToSharedRef());
 				}
@@ -677,7 +684,7 @@ void UFINLuaProcessor::Reset() {
 	}
 	const FTCHARToUTF8 CodeConv(*EEPROM->GetCode(), EEPROM->GetCode().Len());
 	const std::string code = std::string(CodeConv.Get(), CodeConv.Length());
-	luaL_loadbuffer(luaThread, code.c_str(), code.size(), "=EEPROM");
+	FINLua::luaFIN_loadBufferCached(luaThread, code.c_str(), code.size(), "=EEPROM");
 	if (lua_isstring(luaThread, -1)) {
 		// Syntax error
 		Kernel->Crash(MakeShared<FFINKernelCrash>(lua_tostring(luaThread, -1)));
@@ -687,8 +694,52 @@ void UFINLuaProcessor::Reset() {
 	// reset tick state
 	tickHelper.reset();
 
-	// lua_gc(luaState, LUA_GCSETPAUSE, 100);
-	// TODO: Check if we actually want to use this or the manual gc call
+	// incremental collection, manual steps get added after every tick by CollectGarbage
+	lua_gc(luaState, LUA_GCINC, 0, 0, 0);
+	ScriptCycles = 0;
+	GCCycles = 0;
+	GCFullCollects = 0;
+}
+
+void UFINLuaProcessor::CollectGarbage(uint64 InScriptCycles) {
+	ZoneScopedN("Lua GC");
+	const uint64 Start = FPlatformTime::Cycles64();
+	
+	// the kernel usage got cached before the script ran, so measure the lua state itself
+	const int64 Capacity = Kernel ? Kernel->GetCapacity() : 0;
+	if (Capacity > 0 && GetMemoryUsage() >= Capacity * 0.9) {
+		// close to out of memory -> free as much as possible
+		CollectAllGarbage();
+		return;
+	}
+	
+	// spend a fourth of the script time (at least 50us) on incremental steps, stop early if the cycle finished
+	const uint64 Budget = FMath::Max<uint64>(InScriptCycles / 4, FPlatformTime::SecondsToCycles64(0.00005));
+	while (!lua_gc(luaState, LUA_GCSTEP, 0)) {
+		if (FPlatformTime::Cycles64() - Start >= Budget) break;
+	}
+	
+	GCCycles += FPlatformTime::Cycles64() - Start;
+}
+
+void UFINLuaProcessor::CollectAllGarbage() {
+	ZoneScopedN("Lua Full GC");
+	const uint64 Start = FPlatformTime::Cycles64();
+	lua_gc(luaState, LUA_GCCOLLECT, 0);
+	++GCFullCollects;
+	GCCycles += FPlatformTime::Cycles64() - Start;
+}
+
+double UFINLuaProcessor::GetScriptTime() const {
+	return FPlatformTime::ToSeconds64(ScriptCycles);
+}
+
+double UFINLuaProcessor::GetGCTime() const {
+	return FPlatformTime::ToSeconds64(GCCycles);
+}
+
+uint64 UFINLuaProcessor::GetGCFullCollects() const {
+	return GCFullCollects;
 }
 
 int64 UFINLuaProcessor::GetMemoryUsage(bool bInRecalc) {
@@ -699,6 +750,10 @@ void UFINLuaProcessor::SetEEPROM(AFINStateEEPROM* InEEPROM) {
 	EEPROM = Cast<AFINStateEEPROMLua>(InEEPROM);
 }
 
+void UFINLuaProcessor::FuturesResolved() {
+	tickHelper.futureResolved();
+}
+
 AFINStateEEPROMLua* UFINLuaProcessor::GetEEPROM() const {
 	return EEPROM.Get();
 }
@@ -711,24 +766,47 @@ bool UFINLuaProcessor::PullTimeoutReached() {
 	return Timeout <= (static_cast<double>((FDateTime::Now() - FFicsItNetworksModule::GameStart).GetTotalMilliseconds() - PullStart) / 1000.0);
 }
 
-int UFINLuaProcessor::DoSignal(lua_State* L) {
-	UFINKernelNetworkController* net = GetKernel()->GetNetwork();
-	if (!net || net->GetSignalCount() < 1) return 0;
-	FFINNetworkTrace sender;
-	FFINSignalData signal = net->PopSignal(sender); 
+static int luaPushSignal(lua_State* L, const FFINSignalData& Signal, const FFINNetworkTrace& Sender) {
 	int props = 2;
-	if (signal.Signal) lua_pushstring(L, TCHAR_TO_UTF8(*signal.Signal->GetInternalName()));
+	if (Signal.Signal) lua_pushstring(L, TCHAR_TO_UTF8(*Signal.Signal->GetInternalName()));
 	else lua_pushnil(L);
-	FINLua::luaFIN_pushObject(L, UFINNetworkUtils::RedirectIfPossible(sender));
-	for (const FFINAnyNetworkValue& Value : signal.Data) {
-		FINLua::luaFIN_pushNetworkValue(L, Value, sender);
+	FINLua::luaFIN_pushObject(L, UFINNetworkUtils::RedirectIfPossible(Sender));
+	for (const FFINAnyNetworkValue& Value : Signal.GetData()) {
+		FINLua::luaFIN_pushNetworkValue(L, Value, Sender);
 		props++;
 	}
 	return props;
 }
 
+int UFINLuaProcessor::DoSignal(lua_State* L) {
+	UFINKernelNetworkController* net = GetKernel()->GetNetwork();
+	if (!net || net->GetSignalCount() < 1) return 0;
+	TArray<TPair<FFINSignalData, FFINNetworkTrace>> Signals;
+	if (net->PopSignals(Signals, 1) < 1) return 0;
+	return luaPushSignal(L, Signals[0].Key, Signals[0].Value);
+}
+
+int UFINLuaProcessor::DoSignals(lua_State* L, int InMaxCount) {
+	UFINKernelNetworkController* net = GetKernel()->GetNetwork();
+	TArray<TPair<FFINSignalData, FFINNetworkTrace>> Signals;
+	if (net) net->PopSignals(Signals, InMaxCount);
+	lua_createtable(L, Signals.Num(), 0);
+	int i = 0;
+	for (const TPair<FFINSignalData, FFINNetworkTrace>& Signal : Signals) {
+		const int props = luaPushSignal(L, Signal.Key, Signal.Value);
+		lua_createtable(L, props, 0);
+		lua_insert(L, -props-1);
+		for (int j = props; j > 0; --j) {
+			lua_seti(L, -j-1, j);
+		}
+		lua_seti(L, -2, ++i);
+	}
+	return Signals.Num();
+}
+
 void UFINLuaProcessor::luaHook(lua_State* L, lua_Debug* ar) {
-	//UFINLuaProcessor* p = UFINLuaProcessor::luaGetProcessor(L);
+	UFINLuaProcessor* p = UFINLuaProcessor::luaGetProcessor(L);
+	p->tickHelper.stepsExhausted();
 	//p->tickHelper.tickHook(L);
 	lua_yield(L, 0);
 }
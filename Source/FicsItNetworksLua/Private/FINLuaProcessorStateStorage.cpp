@@ -4,15 +4,33 @@
 #include "FicsItNetworksModule.h"
 #include "Network/FINDynamicStructHolder.h"
 #include "Utils/FINUtils.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+
+namespace {
+	const TCHAR* LuaDataBinaryFormat = TEXT("Binary1");
+}
 
 bool FFINLuaProcessorStateStorage::Serialize(FStructuredArchive::FSlot Slot) {
 	if (!Slot.GetUnderlyingArchive().IsSaveGame()) return false;
 	FStructuredArchive::FRecord Record = Slot.EnterRecord();
 	Record.EnterField(SA_FIELD_NAME(TEXT("Traces"))).GetUnderlyingArchive() << Traces;
 	Record.EnterField(SA_FIELD_NAME(TEXT("References"))) << References;
-	Record.EnterField(SA_FIELD_NAME(TEXT("Thread"))) << LuaData;
-	FString Str;
-	Record.EnterField(SA_FIELD_NAME(TEXT("Globals"))) << Str;
+	Record.EnterField(SA_FIELD_NAME(TEXT("Thread"))) << LegacyLuaData;
+	// previously unused, empty in saves using the Base64 format
+	FString Format = LuaDataBinaryFormat;
+	Record.EnterField(SA_FIELD_NAME(TEXT("Globals"))) << Format;
+	if (Format == LuaDataBinaryFormat) {
+		FString Compression = LuaDataCompression.ToString();
+		Record.EnterField(SA_FIELD_NAME(TEXT("Compression"))) << Compression;
+		LuaDataCompression = FName(Compression);
+		Record.EnterField(SA_FIELD_NAME(TEXT("Size"))) << LuaDataSize;
+		Record.EnterField(SA_FIELD_NAME(TEXT("Data"))) << LuaData;
+	} else {
+		LuaData.Empty();
+		LuaDataSize = 0;
+		LuaDataCompression = NAME_None;
+	}
 
 	FVersion version = UFINUtils::GetFINSaveVersion(GWorld);
 	if (FVersion(0, 3, 19).Compare(version) == 1) return false;
@@ -66,4 +84,53 @@ void FFINLuaProcessorStateStorage::Clear() {
 	References.Empty();
 	Structs.Empty();
 	LuaData.Empty();
+	LuaDataSize = 0;
+	LuaDataCompression = NAME_None;
+	LegacyLuaData.Empty();
+}
+
+void FFINLuaProcessorStateStorage::SetLuaData(const uint8* InData, int64 InSize) {
+	LegacyLuaData.Empty();
+	LuaDataSize = InSize;
+	
+	if (InSize <= MAX_int32) {
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, static_cast<int32>(InSize));
+		LuaData.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_LZ4, LuaData.GetData(), CompressedSize, InData, static_cast<int32>(InSize))) {
+			LuaData.SetNum(CompressedSize);
+			LuaDataCompression = NAME_LZ4;
+			return;
+		}
+	}
+	
+	UE_LOG(LogFicsItNetworksLua, Warning, TEXT("Unable to compress lua state of %lld bytes, storing it uncompressed"), InSize);
+	LuaData = TArray<uint8>(InData, InSize);
+	LuaDataCompression = NAME_None;
+}
+
+bool FFINLuaProcessorStateStorage::GetLuaData(TArray<uint8>& OutData) const {
+	OutData.Empty();
+	if (!LegacyLuaData.IsEmpty()) {
+		return FBase64::Decode(LegacyLuaData, OutData) && OutData.Num() > 1;
+	}
+	if (LuaDataSize <= 1) return false;
+	
+	if (LuaDataCompression.IsNone()) {
+		OutData = LuaData;
+		return LuaData.Num() == LuaDataSize;
+	}
+	
+	if (LuaDataSize > MAX_int32) return false;
+	OutData.SetNumUninitialized(LuaDataSize);
+	if (!FCompression::UncompressMemory(LuaDataCompression, OutData.GetData(), static_cast<int32>(LuaDataSize), LuaData.GetData(), LuaData.Num())) {
+		UE_LOG(LogFicsItNetworksLua, Warning, TEXT("Unable to decompress lua state of %lld bytes"), LuaDataSize);
+		OutData.Empty();
+		return false;
+	}
+	return true;
+}
+
+int64 FFINLuaProcessorStateStorage::GetLuaDataStoredSize() const {
+	if (!LegacyLuaData.IsEmpty()) return LegacyLuaData.Len() * sizeof(TCHAR);
+	return LuaData.Num();
 }
@@ -0,0 +1,236 @@
+#include "FINLuaScheduler.h"
+
+#include "FicsItNetworksLuaModule.h"
+#include "HAL/RunnableThread.h"
+
+#include "tracy/Tracy.hpp"
+
+namespace {
+	FCriticalSection SchedulerInstanceMutex;
+	std::atomic<FFINLuaScheduler*> SchedulerInstance = nullptr;
+}
+
+FFINLuaSchedulerTask::FFINLuaSchedulerTask() {
+	SyncEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FFINLuaSchedulerTask::~FFINLuaSchedulerTask() {
+	FPlatformProcess::ReturnSynchEventToPool(SyncEvent);
+}
+
+FFINLuaScheduler::FWorker::FWorker(FFINLuaScheduler* Scheduler, int32 Index) : Scheduler(Scheduler), Index(Index) {}
+
+uint32 FFINLuaScheduler::FWorker::Run() {
+	while (!Scheduler->bShouldStop) {
+		FFINLuaSchedulerTask* Task = Scheduler->PopTask(Index);
+		if (!Task) {
+			Scheduler->WorkAvailable->Wait(10);
+			continue;
+		}
+		Scheduler->RunTask(Task, Index);
+	}
+	return 0;
+}
+
+FFINLuaScheduler::FFINLuaScheduler(int32 InWorkerCount) {
+	WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+	SyncJoinEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	InWorkerCount = FMath::Max(InWorkerCount, 1);
+	for (int32 i = 0; i < InWorkerCount; ++i) {
+		Workers.Add(MakeUnique<FWorker>(this, i));
+	}
+	for (const TUniquePtr<FWorker>& Worker : Workers) {
+		Worker->Thread = FRunnableThread::Create(Worker.Get(), *FString::Printf(TEXT("FIN Lua Worker %i"), Worker->Index), 0, TPri_Normal);
+	}
+	UE_LOG(LogFicsItNetworksLua, Display, TEXT("Lua Scheduler started with %i worker threads"), Workers.Num());
+}
+
+FFINLuaScheduler::~FFINLuaScheduler() {
+	bShouldStop = true;
+	{
+		FScopeLock Lock(&SyncMutex);
+		for (FFINLuaSchedulerTask* Task : PendingSync) {
+			Task->SyncEvent->Trigger();
+		}
+		PendingSync.Empty();
+	}
+	for (const TUniquePtr<FWorker>& Worker : Workers) {
+		WorkAvailable->Trigger();
+	}
+	for (const TUniquePtr<FWorker>& Worker : Workers) {
+		if (Worker->Thread) {
+			Worker->Thread->WaitForCompletion();
+			delete Worker->Thread;
+		}
+	}
+	Workers.Empty();
+	FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+	FPlatformProcess::ReturnSynchEventToPool(SyncJoinEvent);
+}
+
+FFINLuaScheduler& FFINLuaScheduler::Get() {
+	FFINLuaScheduler* Scheduler = SchedulerInstance.load(std::memory_order_acquire);
+	if (!Scheduler) {
+		FScopeLock Lock(&SchedulerInstanceMutex);
+		Scheduler = SchedulerInstance.load(std::memory_order_relaxed);
+		if (!Scheduler) {
+			Scheduler = new FFINLuaScheduler(FMath::Clamp(FPlatformMisc::NumberOfWorkerThreadsToSpawn() / 2, 1, 8));
+			SchedulerInstance.store(Scheduler, std::memory_order_release);
+		}
+	}
+	return *Scheduler;
+}
+
+void FFINLuaScheduler::Shutdown() {
+	FScopeLock Lock(&SchedulerInstanceMutex);
+	delete SchedulerInstance.exchange(nullptr);
+}
+
+void FFINLuaScheduler::Schedule(FFINLuaSchedulerTask* Task) {
+	FScopeLock TaskLock(&Task->ScheduleMutex);
+	if (Task->bScheduled) return;
+	Task->bScheduled = true;
+	Task->bCanceled = false;
+	Task->bQueued = true;
+	Enqueue(Task, NextQueue++ % Workers.Num());
+}
+
+void FFINLuaScheduler::Enqueue(FFINLuaSchedulerTask* Task, int32 WorkerIndex) {
+	FWorker& Worker = *Workers[WorkerIndex];
+	{
+		FScopeLock Lock(&Worker.QueueMutex);
+		Worker.Queue.Add(Task);
+	}
+	WorkAvailable->Trigger();
+}
+
+FFINLuaSchedulerTask* FFINLuaScheduler::PopTask(int32 WorkerIndex) {
+	// take the oldest task of the own queue, or steal the newest task from the other queues
+	for (int32 i = 0; i < Workers.Num(); ++i) {
+		FWorker& Worker = *Workers[(WorkerIndex + i) % Workers.Num()];
+		FFINLuaSchedulerTask* Task = nullptr;
+		{
+			FScopeLock Lock(&Worker.QueueMutex);
+			if (Worker.Queue.Num() < 1) continue;
+			if (i == 0) {
+				Task = Worker.Queue[0];
+				Worker.Queue.RemoveAt(0, 1, false);
+			} else {
+				Task = Worker.Queue.Pop(false);
+			}
+			// announced while the queue still holds the task, so a cancel removing it from the queues waits for this pop
+			++Task->PopsInFlight;
+		}
+
+		bool bClaimed = false;
+		{
+			// the task might have been canceled and rescheduled in the meantime, then the queue entry is outdated
+			FScopeLock TaskLock(&Task->ScheduleMutex);
+			if (Task->bQueued && !Task->bCanceled) {
+				Task->bQueued = false;
+				Task->bRunning = true;
+				bClaimed = true;
+			}
+		}
+		// a canceled task may get destroyed right after this, so it must not get touched anymore
+		--Task->PopsInFlight;
+		if (bClaimed) return Task;
+	}
+	return nullptr;
+}
+
+void FFINLuaScheduler::RunTask(FFINLuaSchedulerTask* Task, int32 WorkerIndex) {
+	const uint64 Start = FPlatformTime::Cycles64();
+	bool bContinue;
+	{
+		ZoneScopedN("FIN Lua Slice");
+		bContinue = Task->RunSlice();
+	}
+	const uint64 Cycles = FPlatformTime::Cycles64() - Start;
+	++Task->SliceCount;
+	Task->SliceCycles += Cycles;
+	Task->LastSliceCycles = Cycles;
+
+	if (Task->bInSync.exchange(false)) {
+		if (ActiveSync.fetch_sub(1) == 1) SyncJoinEvent->Trigger();
+	}
+
+	FScopeLock TaskLock(&Task->ScheduleMutex);
+	Task->bRunning = false;
+	if (bContinue && !Task->bCanceled) {
+		// queue at the end of the own queue, so every other task gets its turn first
+		Task->bQueued = true;
+		Enqueue(Task, WorkerIndex);
+	} else {
+		Task->bScheduled = false;
+	}
+}
+
+void FFINLuaScheduler::Cancel(FFINLuaSchedulerTask* Task) {
+	{
+		FScopeLock TaskLock(&Task->ScheduleMutex);
+		if (!Task->bScheduled) return;
+		Task->bCanceled = true;
+	}
+
+	// continue the task if it waits for sync, so it is able to finish its slice
+	{
+		FScopeLock Lock(&SyncMutex);
+		if (PendingSync.Remove(Task) > 0) Task->SyncEvent->Trigger();
+	}
+
+	while (Task->bRunning) FPlatformProcess::Yield();
+
+	FScopeLock TaskLock(&Task->ScheduleMutex);
+	if (Task->bQueued) {
+		for (const TUniquePtr<FWorker>& Worker : Workers) {
+			FScopeLock Lock(&Worker->QueueMutex);
+			Worker->Queue.Remove(Task);
+		}
+		Task->bQueued = false;
+	}
+	Task->bScheduled = false;
+	TaskLock.Unlock();
+
+	// workers that took the task out of a queue before the cancel still check its state
+	while (Task->PopsInFlight > 0) FPlatformProcess::Yield();
+}
+
+void FFINLuaScheduler::WaitForSync(FFINLuaSchedulerTask* Task) {
+	{
+		FScopeLock Lock(&SyncMutex);
+		if (Task->bCanceled || bShouldStop) return;
+		PendingSync.Add(Task);
+	}
+	Task->SyncEvent->Wait();
+}
+
+void FFINLuaScheduler::SyncJoin() {
+	TArray<FFINLuaSchedulerTask*> Tasks;
+	{
+		FScopeLock Lock(&SyncMutex);
+		if (PendingSync.Num() < 1) return;
+		Tasks = MoveTemp(PendingSync);
+		PendingSync.Reset();
+		ActiveSync = Tasks.Num();
+		for (FFINLuaSchedulerTask* Task : Tasks) {
+			Task->bInSync = true;
+		}
+	}
+
+	ZoneScopedN("FIN Lua Sync Join");
+	for (FFINLuaSchedulerTask* Task : Tasks) {
+		Task->OnSyncBegin();
+		Task->SyncEvent->Trigger();
+	}
+	SyncJoinEvent->Wait();
+}
+
+void FFINLuaScheduler::EndFrame() {
+	const uint64 Used = FrameSyncCycles.exchange(0);
+	const float Scale = SyncBudgetScale;
+	// scale slices proportional to the overuse, grow back slowly once there is room again
+	float Target = 1.0f;
+	if (Used > 0) Target = FMath::Clamp(Scale * static_cast<float>(SyncFrameBudget / FPlatformTime::ToSeconds64(Used)), MinSyncBudgetScale, 1.0f);
+	SyncBudgetScale = FMath::Lerp(Scale, Target, 0.25f);
+}
@@ -0,0 +1,93 @@
+#include "FINLuaScheduler.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace {
+	/**
+	 * Stands in for a lua processor, runs a fixed amount of slices
+	 * and waits for sync every few slices like a processor doing sync calls.
+	 */
+	class FFINLuaSchedulerDummyTask : public FFINLuaSchedulerTask {
+	public:
+		int32 SlicesToRun;
+		int32 SyncInterval;
+		std::atomic<int32> SlicesRun = 0;
+		std::atomic<int32> SyncsBegun = 0;
+		std::atomic<int32> Concurrent = 0;
+		std::atomic<bool> bOverlapped = false;
+		FFINLuaScheduler* Scheduler = nullptr;
+
+		FFINLuaSchedulerDummyTask(FFINLuaScheduler* Scheduler, int32 SlicesToRun, int32 SyncInterval) : SlicesToRun(SlicesToRun), SyncInterval(SyncInterval), Scheduler(Scheduler) {}
+
+		// Begin FFINLuaSchedulerTask
+		virtual bool RunSlice() override {
+			if (Concurrent.fetch_add(1) != 0) bOverlapped = true;
+			const int32 Slice = ++SlicesRun;
+			if (SyncInterval > 0 && Slice % SyncInterval == 0) Scheduler->WaitForSync(this);
+			volatile uint32 Work = 0;
+			for (int32 i = 0; i < 1000; ++i) Work += i;
+			Concurrent.fetch_sub(1);
+			return Slice < SlicesToRun;
+		}
+
+		virtual void OnSyncBegin() override {
+			++SyncsBegun;
+		}
+		// End FFINLuaSchedulerTask
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFINLuaSchedulerStressTest, "FicsItNetworks.Lua.Scheduler.Stress", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFINLuaSchedulerStressTest::RunTest(const FString& Parameters) {
+	constexpr int32 TaskCount = 500;
+	constexpr int32 SliceCount = 200;
+
+	FFINLuaScheduler Scheduler(4);
+	TArray<TUniquePtr<FFINLuaSchedulerDummyTask>> Tasks;
+	for (int32 i = 0; i < TaskCount; ++i) {
+		Tasks.Add(MakeUnique<FFINLuaSchedulerDummyTask>(&Scheduler, SliceCount, (i % 3 == 0) ? 0 : 5 + i % 20));
+	}
+	for (const TUniquePtr<FFINLuaSchedulerDummyTask>& Task : Tasks) {
+		Scheduler.Schedule(Task.Get());
+	}
+
+	// act as game thread, cancel and reschedule or replace some tasks in between like demoting or destroyed processors would
+	const double Timeout = FPlatformTime::Seconds() + 60.0;
+	int32 Frame = 0;
+	while (Tasks.ContainsByPredicate([](const TUniquePtr<FFINLuaSchedulerDummyTask>& Task) { return Task->IsScheduled(); })) {
+		if (FPlatformTime::Seconds() > Timeout) break;
+		Scheduler.SyncJoin();
+		const int32 Index = Frame++ % TaskCount;
+		FFINLuaSchedulerDummyTask* Task = Tasks[Index].Get();
+		if (Task->IsScheduled()) {
+			Scheduler.Cancel(Task);
+			TestFalse(TEXT("Task is not scheduled after cancel"), Task->IsScheduled());
+			if (Frame % 4 == 0) {
+				// destroy the task right after the cancel like a destroyed processor, workers might have just popped it
+				Tasks[Index] = MakeUnique<FFINLuaSchedulerDummyTask>(&Scheduler, SliceCount, Task->SyncInterval);
+				Task = Tasks[Index].Get();
+			}
+			Scheduler.Schedule(Task);
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	for (const TUniquePtr<FFINLuaSchedulerDummyTask>& Task : Tasks) {
+		Scheduler.Cancel(Task.Get());
+	}
+
+	for (const TUniquePtr<FFINLuaSchedulerDummyTask>& Task : Tasks) {
+		TestFalse(TEXT("Task slices never run concurrently"), Task->bOverlapped.load());
+		TestTrue(TEXT("Task ran all its slices"), Task->SlicesRun >= SliceCount);
+		TestEqual(TEXT("Slice accounting matches"), static_cast<int32>(Task->GetSliceCount()), Task->SlicesRun.load());
+		if (Task->SyncInterval == 0) {
+			TestEqual(TEXT("Task without sync never got synced"), Task->SyncsBegun.load(), 0);
+		}
+	}
+	return true;
+}
+
+#endif
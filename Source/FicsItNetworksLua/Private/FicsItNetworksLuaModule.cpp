@@ -2,6 +2,7 @@
 
 #include "FGGameMode.h"
 #include "FINLuaRCO.h"
+#include "FINLuaScheduler.h"
 #include "Patching/NativeHookManager.h"
 
 DEFINE_LOG_CATEGORY(LogFicsItNetworksLua);
@@ -17,7 +18,16 @@ void FFicsItNetworksLuaModule::StartupModule() {
 		});
 #endif
 	});
+
+	// single sync point of all async lua ticks, after all actors and factory ticks of the frame are done
+	FWorldDelegates::OnWorldPostActorTick.AddLambda([](UWorld* World, ELevelTick TickType, float DeltaSeconds) {
+		if (!World->IsGameWorld()) return;
+		FFINLuaScheduler& Scheduler = FFINLuaScheduler::Get();
+		Scheduler.SyncJoin();
+		Scheduler.EndFrame();
+	});
 }
 
 void FFicsItNetworksLuaModule::ShutdownModule() {
+	FFINLuaScheduler::Shutdown();
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "FINLua.h"
+#include "Misc/SecureHash.h"
+
+namespace FINLua {
+	/**
+	 * Process wide cache of compiled lua chunks shared by all lua processors.
+	 * Chunks are keyed by the hash of their source code and chunk name,
+	 * so a changed source simply misses the cache and unused entries get evicted once the memory limit is reached.
+	 */
+	class FICSITNETWORKSLUA_API FFINLuaChunkCache {
+		struct FEntry {
+			TArray<uint8> Bytecode;
+			uint64 LastUse = 0;
+		};
+
+		FCriticalSection Mutex;
+		TMap<FSHAHash, FEntry> Entries;
+		int64 Size = 0;
+		int64 MaxSize;
+		uint64 UseCounter = 0;
+
+		void Evict(int64 InRequiredSize);
+
+	public:
+		explicit FFINLuaChunkCache(int64 InMaxSize);
+
+		/**
+		 * Returns the cache used by all lua processors
+		 */
+		static FFINLuaChunkCache& Get();
+
+		/**
+		 * Computes the cache key for the given source code and chunk name.
+		 */
+		static FSHAHash Hash(const char* InCode, size_t InSize, const char* InChunkName);
+
+		/**
+		 * Copies the compiled chunk with the given key into the given array.
+		 *
+		 * @return	false if the chunk is not cached
+		 */
+		bool Find(const FSHAHash& InKey, TArray<uint8>& OutBytecode);
+
+		/**
+		 * Adds the given compiled chunk to the cache, evicts the least recently used chunks if the memory limit is reached.
+		 * Chunks bigger than the memory limit don't get cached.
+		 */
+		void Add(const FSHAHash& InKey, TArray<uint8>&& InBytecode);
+
+		/**
+		 * Removes all cached chunks
+		 */
+		void Empty();
+
+		/**
+		 * Returns the amount of memory in bytes used by the cached chunks
+		 */
+		int64 GetSize() const { return Size; }
+	};
+
+	/**
+	 * Loads the given lua source code as text chunk like luaL_loadbufferx does.
+	 * Uses the compiled chunk from the chunk cache if the same code was already compiled before,
+	 * otherwise compiles it and adds the compiled chunk to the cache.
+	 *
+	 * @param[in]	L			the lua state the loaded function or error message gets pushed to
+	 * @param[in]	InCode		the lua source code
+	 * @param[in]	InSize		the length of the source code
+	 * @param[in]	InChunkName	the name of the chunk used in error messages and debug information
+	 * @return	the status code of the load, same as luaL_loadbufferx
+	 */
+	int luaFIN_loadBufferCached(lua_State* L, const char* InCode, size_t InSize, const char* InChunkName);
+}
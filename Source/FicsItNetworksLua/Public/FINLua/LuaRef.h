@@ -81,6 +81,21 @@ namespace FINLua {
 	 */
 	int luaFIN_pushFunctionOrGetProperty(lua_State* L, int Index, UFINStruct* Type, const FString& MemberName, EFINFunctionFlags FunctionFilterFlags, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx, bool bCauseError = true);
 
+	/**
+	 * @brief Pushes the value of the get property, or a Reflection Function with the member name at the given index onto the stack, If property executed failed, causes a lua error.
+	 * Resolved members are cached per type in the lua registry, so repeated lookups don't need to search the reflection type again.
+	 * @param L the lua state
+	 * @param Index the argument index used for the optional lua arg error
+	 * @param Type the Reflection Type that will be used to search the property or function
+	 * @param NameIndex the index of the lua value holding the function or property name that will be searched
+	 * @param FunctionFilterFlags function flags that will be used as filter when searching for a function
+	 * @param PropertyFilterFlags property flags that will be used as filter when searching for a property
+	 * @param PropertyCtx the execution context that will be used for the get property, if such property got found
+	 * @param bCauseError if true, causes a lua error
+	 * @return 0 if unable to find a property or function with the given name, otherwise 1.
+	 */
+	int luaFIN_pushFunctionOrGetProperty(lua_State* L, int Index, UFINStruct* Type, int NameIndex, EFINFunctionFlags FunctionFilterFlags, EFINRepPropertyFlags PropertyFilterFlags, const FFINExecutionContext& PropertyCtx, bool bCauseError = true);
+
 	/**
 	 * @brief Tries to execute the SetProperty with the value at the given index in the lua stack, if no SetProperty was found, pushes nothing. Causes a lua error if property execution failed.
 	 * @param L the lua state
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "FINLuaProcessorStateStorage.h"
+#include "FINLuaScheduler.h"
 #include "FicsItKernel/FicsItFS/Library/Listener.h"
 #include "FicsItKernel/Processor/Processor.h"
 #include "FINLua/LuaFileSystemAPI.h"
@@ -38,35 +39,26 @@ enum LuaTickState {
 };
 ENUM_CLASS_FLAGS(LuaTickState);
 
-struct FICSITNETWORKSLUA_API FLuaTickRunnable : public FNonAbandonableTask {
-private:
-	class FFINLuaProcessorTick* Tick;
-	
-public:	
-	FLuaTickRunnable(class FFINLuaProcessorTick* Tick) : Tick(Tick) {}
+class FICSITNETWORKSLUA_API FFINLuaProcessorTick : public FFINLuaSchedulerTask {
+	// Wall time a single lua tick should take, the instruction budget gets tuned towards it
+	static constexpr double SyncSliceTarget = 0.0001;
+	static constexpr double AsyncSliceTarget = 0.001;
+	static constexpr int MinSteps = 250;
+	static constexpr int MaxSteps = 100000;
 	
-	void DoWork();
-
-	// ReSharper disable once CppMemberFunctionMayBeStatic
-	FORCEINLINE TStatId GetStatId() const {
-		RETURN_QUICK_DECLARE_CYCLE_STAT(ExampleAsyncTask, STATGROUP_ThreadPoolAsyncTasks);
-	}
-};
-
-class FICSITNETWORKSLUA_API FFINLuaProcessorTick {
-	// Lua Tick state lua step lengths
+	// Lua Tick state lua step lengths, error and end lengths are fractions of these
 	int SyncLen = 2500;
-	int SyncErrorLen = 1250;
-	int SyncEndLen = 500;
 	int AsyncLen = 2500;
-	int AsyncErrorLen = 1200;
-	int AsyncEndLen = 500;
+	// Moving average of the wall time in seconds a single instruction took
+	double SyncStepCost = 0.0;
+	double AsyncStepCost = 0.0;
+	bool bStepsExhausted = false;
+	// Cycles the current tick spent waiting for the sync join, they are no cost of the script
+	uint64 SyncWaitCycles = 0;
 	
 private:
 	class UFINLuaProcessor* Processor = nullptr;
 	LuaTickState State = LUA_SYNC;
-	FLuaTickRunnable Runnable;
-	TSharedPtr<FAsyncTask<FLuaTickRunnable>> asyncTask;
 	FCriticalSection StateMutex;
 	FCriticalSection TickMutex;
 	bool bShouldPromote = false;
@@ -74,19 +66,21 @@ private:
 	bool bShouldStop = false;
 	bool bShouldReset = false;
 	bool bShouldCrash = false;
-	bool bDoSync = false;
-	bool bWaitForSignal = false;
+	std::atomic<bool> bWaitForSignal = false;
+	std::atomic<bool> bWaitForFuture = false;
 	TSharedPtr<FFINKernelCrash> ToCrash;
-	TPromise<void> AsyncSync;
-	TPromise<void> SyncAsync;
-	FCriticalSection AsyncSyncMutex;
 	
 public:
 
 	FFINLuaProcessorTick();
 	FFINLuaProcessorTick(class UFINLuaProcessor* Processor);
 
-	~FFINLuaProcessorTick();
+	virtual ~FFINLuaProcessorTick() override;
+
+	// Begin FFINLuaSchedulerTask
+	virtual bool RunSlice() override;
+	virtual void OnSyncBegin() override;
+	// End FFINLuaSchedulerTask
 
 	void reset();
 	void stop();
@@ -99,8 +93,17 @@ public:
 	void shouldDemote();
 	void shouldWaitForSignal();
 	void signalFound();
+	void shouldWaitForFuture();
+	void futureResolved();
 	void shouldCrash(const TSharedRef<FFINKernelCrash>& Crash);
 	int steps() const;
+	void stepsExhausted();
+	void updateSteps(uint64 InTickCycles, bool bInSync);
+
+	/**
+	 * Returns the cycles the tick spent waiting for the sync join since the last call.
+	 */
+	uint64 consumeSyncWaitCycles();
 	
 	void syncTick();
 	bool asyncTick();
@@ -119,7 +122,6 @@ class FICSITNETWORKSLUA_API UFINLuaProcessor : public UFINKernelProcessor {
 
 	friend int FINLua::luaPull(lua_State* L);
 	friend int luaComputerSkip(lua_State* L);
-	friend FLuaTickRunnable;
 	friend struct FLuaSyncCall;
 	friend FFINLuaProcessorTick;
 
@@ -152,6 +154,25 @@ private:
 	
 	void OnPreGarbageCollection();
 	void OnPostGarbageCollection();
+
+	// lua garbage collection
+	uint64 ScriptCycles = 0;
+	uint64 GCCycles = 0;
+	uint64 GCFullCollects = 0;
+
+	/**
+	 * Runs the lua garbage collector after the runtime yielded.
+	 * Does incremental steps for a time budget relative to the time the script ran,
+	 * only does a full collect if the memory usage is close to the capacity.
+	 *
+	 * @param[in]	InScriptCycles	the cycles the script ran prior to the yield
+	 */
+	void CollectGarbage(uint64 InScriptCycles);
+
+	/**
+	 * Frees all garbage of the lua state at once.
+	 */
+	void CollectAllGarbage();
 	
 public:
 	UPROPERTY(SaveGame)
@@ -182,6 +203,7 @@ public:
 	virtual void Reset() override;
 	virtual int64 GetMemoryUsage(bool bInRecalc = false) override;
 	virtual void SetEEPROM(AFINStateEEPROM* InEEPROM) override;
+	virtual void FuturesResolved() override;
 	// End Processor
 
 	/**
@@ -216,6 +238,17 @@ public:
 	 * @return	the count of values we have pushed.
 	 */
 	int DoSignal(lua_State* L);
+
+	/**
+	 * Pops up to the given amount of signals from the signal queue in the network controller at once
+	 * and pushes a sequence table containing one table per signal to the given lua stack.
+	 * Each signal table contains the signal name, the sender and the signal parameters.
+	 *
+	 * @param[in]	L			the stack were the table should get pushed to.
+	 * @param[in]	InMaxCount	the maximum amount of signals to pop
+	 * @return	the amount of signals we have popped.
+	 */
+	int DoSignals(lua_State* L, int InMaxCount);
 	
 	void ClearFileStreams();
 	TArray<FINLua::LuaFile> GetFileStreams() const;
@@ -236,6 +269,21 @@ public:
 	 */
 	static int luaAPIReturn(lua_State* L, int args);
 
+	/**
+	 * Returns the total time in seconds the lua runtime spent executing the script since the last reset
+	 */
+	double GetScriptTime() const;
+
+	/**
+	 * Returns the total time in seconds the lua runtime spent collecting garbage since the last reset
+	 */
+	double GetGCTime() const;
+
+	/**
+	 * Returns the amount of full garbage collections since the last reset
+	 */
+	uint64 GetGCFullCollects() const;
+
 	/**
 	 * Returns the lua state
 	 */
@@ -20,9 +20,15 @@ private:
 
 	TArray<TSharedPtr<FFINDynamicStructHolder>> Structs;
 
+	// persisted lua state, compressed with LuaDataCompression
+	TArray<uint8> LuaData;
+	int64 LuaDataSize = 0;
+	FName LuaDataCompression;
+
+	// persisted lua state of saves prior to the binary format, Base64 encoded
+	FString LegacyLuaData;
+
 public:
-	UPROPERTY(SaveGame)
-	FString LuaData;
 	
     // Begin Struct
 	bool Serialize(FStructuredArchive::FSlot Slot);
@@ -40,6 +46,27 @@ public:
 
 	TSharedPtr<FFINDynamicStructHolder> GetStruct(int32 id);
 
+	/**
+	 * Compresses and stores the given persisted lua state.
+	 *
+	 * @param[in]	InData	the persisted lua state
+	 * @param[in]	InSize	the length of the persisted lua state in bytes
+	 */
+	void SetLuaData(const uint8* InData, int64 InSize);
+
+	/**
+	 * Decompresses the stored persisted lua state, also reads the Base64 format of older saves.
+	 *
+	 * @param[out]	OutData	the persisted lua state
+	 * @return	false if no valid lua state is stored
+	 */
+	bool GetLuaData(TArray<uint8>& OutData) const;
+
+	/**
+	 * Returns the size in bytes the stored lua state takes in the save game
+	 */
+	int64 GetLuaDataStoredSize() const;
+
 	void Clear();
 };
 
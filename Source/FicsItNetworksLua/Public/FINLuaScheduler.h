@@ -0,0 +1,182 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FFINLuaScheduler;
+
+/**
+ * A task the Lua scheduler is able to run in time slices on one of its worker threads.
+ * F.e. the async tick of a Lua processor.
+ */
+class FICSITNETWORKSLUA_API FFINLuaSchedulerTask {
+	friend FFINLuaScheduler;
+
+	// Scheduling state, transitions are guarded by the schedule mutex
+	FCriticalSection ScheduleMutex;
+	std::atomic<bool> bScheduled = false;
+	std::atomic<bool> bQueued = false;
+	std::atomic<bool> bRunning = false;
+	std::atomic<bool> bCanceled = false;
+	std::atomic<bool> bInSync = false;
+	// Workers that took the task out of a queue and didn't check its state yet
+	std::atomic<int32> PopsInFlight = 0;
+	FEvent* SyncEvent = nullptr;
+
+	// Accounting
+	std::atomic<uint64> SliceCount = 0;
+	std::atomic<uint64> SliceCycles = 0;
+	std::atomic<uint64> LastSliceCycles = 0;
+
+public:
+	FFINLuaSchedulerTask();
+	virtual ~FFINLuaSchedulerTask();
+
+	/**
+	 * Runs one time slice of the task.
+	 * Gets called by one of the worker threads of the scheduler.
+	 *
+	 * @return	true if the task wants to run another time slice
+	 */
+	virtual bool RunSlice() = 0;
+
+	/**
+	 * Gets called on the game thread by the sync join of the scheduler,
+	 * right before the task waiting for sync gets continued.
+	 */
+	virtual void OnSyncBegin() {}
+
+	/**
+	 * Returns true if the task is queued or currently running
+	 */
+	bool IsScheduled() const { return bScheduled; }
+
+	/**
+	 * Returns the amount of time slices this task has run
+	 */
+	uint64 GetSliceCount() const { return SliceCount; }
+
+	/**
+	 * Returns the total time in seconds this task has spent running time slices
+	 */
+	double GetSliceTime() const { return FPlatformTime::ToSeconds64(SliceCycles); }
+
+	/**
+	 * Returns the time in seconds the last time slice of this task took
+	 */
+	double GetLastSliceTime() const { return FPlatformTime::ToSeconds64(LastSliceCycles); }
+};
+
+/**
+ * Runs the async ticks of all Lua processors on a fixed pool of worker threads.
+ * Every worker has its own run queue of tasks, idle workers steal tasks from other queues.
+ * A task only runs one time slice and then gets queued at the end again, so every processor gets its fair share.
+ *
+ * Tasks needing to run in sync with the game wait for the sync join,
+ * which runs once per frame on the game thread, releases all waiting tasks at once
+ * and waits for all of them to finish their slice.
+ */
+class FICSITNETWORKSLUA_API FFINLuaScheduler {
+	// Wall time in seconds all lua ticks in sync with the game together should take per frame
+	static constexpr double SyncFrameBudget = 0.004;
+	static constexpr float MinSyncBudgetScale = 0.05f;
+	
+	class FWorker : public FRunnable {
+	public:
+		FFINLuaScheduler* Scheduler;
+		int32 Index;
+		FRunnableThread* Thread = nullptr;
+		FCriticalSection QueueMutex;
+		TArray<FFINLuaSchedulerTask*> Queue;
+
+		FWorker(FFINLuaScheduler* Scheduler, int32 Index);
+
+		// Begin FRunnable
+		virtual uint32 Run() override;
+		// End FRunnable
+	};
+
+	TArray<TUniquePtr<FWorker>> Workers;
+	FEvent* WorkAvailable = nullptr;
+	std::atomic<bool> bShouldStop = false;
+	std::atomic<uint32> NextQueue = 0;
+
+	FCriticalSection SyncMutex;
+	TArray<FFINLuaSchedulerTask*> PendingSync;
+	std::atomic<int32> ActiveSync = 0;
+	FEvent* SyncJoinEvent = nullptr;
+
+	// Frame budget of lua execution blocking the game
+	std::atomic<uint64> FrameSyncCycles = 0;
+	std::atomic<float> SyncBudgetScale = 1.0f;
+
+	FFINLuaSchedulerTask* PopTask(int32 WorkerIndex);
+	void RunTask(FFINLuaSchedulerTask* Task, int32 WorkerIndex);
+	void Enqueue(FFINLuaSchedulerTask* Task, int32 WorkerIndex);
+
+public:
+	/**
+	 * Creates a new scheduler with the given amount of worker threads
+	 */
+	explicit FFINLuaScheduler(int32 InWorkerCount);
+	~FFINLuaScheduler();
+
+	/**
+	 * Returns the global scheduler used by all Lua processors
+	 */
+	static FFINLuaScheduler& Get();
+
+	/**
+	 * Stops and destroys the global scheduler
+	 */
+	static void Shutdown();
+
+	/**
+	 * Queues the given task so it runs time slices until it no longer wants to.
+	 * Does nothing if the task is already scheduled.
+	 */
+	void Schedule(FFINLuaSchedulerTask* Task);
+
+	/**
+	 * Removes the given task from the run queues, continues it if it is waiting for sync
+	 * and waits until its current time slice is finished.
+	 * Afterwards the task is guaranteed to not run until it gets scheduled again,
+	 * and no worker touches it anymore, so it is safe to destroy.
+	 */
+	void Cancel(FFINLuaSchedulerTask* Task);
+
+	/**
+	 * Blocks the calling task until the next sync join on the game thread continues it.
+	 * Has to get called from within RunSlice of the given task.
+	 */
+	void WaitForSync(FFINLuaSchedulerTask* Task);
+
+	/**
+	 * Continues all tasks waiting for sync and waits until all of them have finished their time slice.
+	 * @note	ONLY FROM THE MAIN THREAD!!!
+	 */
+	void SyncJoin();
+
+	/**
+	 * Adds the given cycles of lua execution in sync with the game to the budget of the current frame.
+	 */
+	void AddSyncCycles(uint64 InCycles) { FrameSyncCycles += InCycles; }
+
+	/**
+	 * Returns the factor all computers should scale their sync time slices with,
+	 * so all of them together stay within the frame budget.
+	 */
+	float GetSyncBudgetScale() const { return SyncBudgetScale; }
+
+	/**
+	 * Finishes the frame budget of the current frame and adjusts the sync budget scale for the next frame.
+	 * @note	ONLY FROM THE MAIN THREAD!!!
+	 */
+	void EndFrame();
+
+	/**
+	 * Returns the amount of worker threads
+	 */
+	int32 GetWorkerCount() const { return Workers.Num(); }
+};